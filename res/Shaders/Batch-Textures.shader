@@ -5,6 +5,11 @@ layout(location = 0) in vec4 position;
 layout(location = 1) in vec4 color;
 layout(location = 2) in vec2 texcoord;
 layout(location = 3) in float texidx;
+#ifdef FLIPBOOK
+layout(location = 4) in vec4 flipbook; // frames, frames per second, time offset [s], atlas columns (`AnimatedVertex`)
+
+uniform float u_Time; // [s], the only per-frame input of the animation
+#endif
 
 uniform mat4 u_MVP;
 out     vec4 v_Color;
@@ -15,7 +20,17 @@ void main()
 {
 	gl_Position = u_MVP * position;
 	v_Color = color;
+#ifdef FLIPBOOK
+	// `texcoord` spans the sprite [0, 1], mapped into the current cell of a row-major atlas: top-left cell first,
+	// `ceil(frames / columns)` rows filling the texture
+	float frames = max(flipbook.x, 1.0), columns = max(flipbook.w, 1.0);
+	float rows = ceil(frames / columns);
+	float frame = mod(floor((u_Time + flipbook.z) * flipbook.y), frames);
+	vec2 cell = vec2(mod(frame, columns), rows - 1.0 - floor(frame / columns)); // texture rows are bottom-up
+	v_TexCoord = (texcoord + cell) / vec2(columns, rows);
+#else
 	v_TexCoord = texcoord;
+#endif
 	v_TexIndex = texidx;
 }
 
@@ -25,7 +40,7 @@ void main()
 
 layout(location = 0) out vec4 color;
 
-uniform sampler2D u_Textures[2];
+uniform sampler2D u_Textures[MAX_TEXTURES]; // injected by `Shader`: every unit the GPU offers
 in vec4 v_Color;
 in vec2 v_TexCoord;
 in float v_TexIndex;
@@ -35,8 +50,6 @@ void main()
 	int index = int(v_TexIndex);
 	// non-constant expressions are forbidden in GLSL 1.30 (GLSL 4.0 supports)
 	//color = texture(u_Textures[index], v_TexCoord);
-	switch (index) {
-	case 0: color = texture(u_Textures[0], v_TexCoord); break;
-	case 1: color = texture(u_Textures[1], v_TexCoord); break;
-	}
+	color = vec4(0.0);
+	SAMPLE_TEXTURES(u_Textures, index, v_TexCoord, color) // generated `switch` over all `MAX_TEXTURES` slots
 }
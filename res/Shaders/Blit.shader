@@ -0,0 +1,19 @@
+#shader vertex
+#version 330 core
+
+#include "Fullscreen.glsl"
+
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+uniform sampler2D u_Texture;
+in vec2 v_TexCoord;
+
+// Copy with bilinear filtering: drawn into a half-size target it averages 2x2 source texels (downsample)
+void main()
+{
+	color = vec4(texture(u_Texture, v_TexCoord).rgb, 1.0);
+}
@@ -0,0 +1,29 @@
+#shader vertex
+#version 330 core
+
+#include "Fullscreen.glsl"
+
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+uniform sampler2D u_Texture;
+uniform vec2 u_Direction; // one texel along the blur axis: (1 / width, 0) or (0, 1 / height)
+in vec2 v_TexCoord;
+
+// Separable 9-tap gaussian in 5 fetches: taps between texel pairs let bilinear filtering do half the work
+const float c_Offsets[3] = float[](0.0, 1.3846153846, 3.2307692308);
+const float c_Weights[3] = float[](0.2270270270, 0.3162162162, 0.0702702703);
+
+void main()
+{
+	vec3 sum = texture(u_Texture, v_TexCoord).rgb * c_Weights[0];
+	for (int i = 1; i < 3; i++)
+	{
+		sum += texture(u_Texture, v_TexCoord + u_Direction * c_Offsets[i]).rgb * c_Weights[i];
+		sum += texture(u_Texture, v_TexCoord - u_Direction * c_Offsets[i]).rgb * c_Weights[i];
+	}
+	color = vec4(sum, 1.0);
+}
@@ -0,0 +1,23 @@
+#shader vertex
+#version 330 core
+
+#include "Fullscreen.glsl"
+
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+uniform sampler2D u_Scene;
+uniform sampler2D u_Bloom;
+uniform float u_Intensity;
+in vec2 v_TexCoord;
+
+// Scene plus the upsampled blur (bilinear) as a cheap bloom/glow
+void main()
+{
+	vec3 scene = texture(u_Scene, v_TexCoord).rgb;
+	vec3 bloom = texture(u_Bloom, v_TexCoord).rgb;
+	color = vec4(scene + bloom * u_Intensity, 1.0);
+}
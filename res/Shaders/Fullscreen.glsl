@@ -0,0 +1,11 @@
+// Vertex stage of full-screen passes: one oversized triangle generated from `gl_VertexID` (no vertex buffer,
+// draw 3 vertices with any VAO bound), covers the viewport with `v_TexCoord` spanning [0, 1]
+
+out vec2 v_TexCoord;
+
+void main()
+{
+	vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2); // (0, 0), (2, 0), (0, 2)
+	v_TexCoord = corner;
+	gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
@@ -0,0 +1,36 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 normal;
+layout(location = 2) in vec2 texcoord;
+
+uniform mat4 u_MVP;
+uniform mat4 u_Model;
+out     vec3 v_Normal;
+out     vec2 v_TexCoord;
+
+void main()
+{
+	gl_Position = u_MVP * vec4(position, 1.0);
+	v_Normal = mat3(u_Model) * normal; // uniform scale only
+	v_TexCoord = texcoord;
+}
+
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+uniform vec4 u_Color;
+uniform vec3 u_LightDirection; // towards the light, normalized
+in vec3 v_Normal;
+in vec2 v_TexCoord;
+
+void main()
+{
+	float diffuse = max(dot(normalize(v_Normal), u_LightDirection), 0.0);
+	float stripes = 0.85 + 0.15 * step(0.5, fract(v_TexCoord.x * 64.0)); // texcoords visible without a texture
+	color = vec4(u_Color.rgb * (0.15 + 0.85 * diffuse) * stripes, u_Color.a);
+}
@@ -0,0 +1,25 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec4 position;
+
+uniform mat4 u_MVP;
+
+void main()
+{
+	gl_Position = u_MVP * position;
+}
+
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+uniform vec4 u_Increment;
+
+// Every shaded fragment adds `u_Increment` (additive blending): brightness is the number of layers written per pixel
+void main()
+{
+	color = u_Increment;
+}
@@ -0,0 +1,37 @@
+// Particle simulation shared by `Particles-Update.shader` (compute, GL 4.3) and `Particles-Feedback.shader` (transform feedback, GL 3.3)
+
+uniform float u_DeltaTime;
+uniform float u_Time;
+uniform vec2  u_Emitter;
+uniform vec2  u_Gravity;
+uniform int   u_Reset; // first step: buffer contents are undefined, respawn everything
+
+// Integer hash -> [0, 1]: every particle gets its own random stream without any CPU-side state
+float Hash(uint x)
+{
+	x ^= x >> 16; x *= 0x7feb352du;
+	x ^= x >> 15; x *= 0x846ca68bu;
+	x ^= x >> 16;
+	return float(x) / 4294967295.0;
+}
+
+void Simulate(uint index, inout vec2 position, inout vec2 velocity, inout float life, inout float lifetime, inout float seed, inout float size)
+{
+	life -= u_DeltaTime;
+	if (u_Reset != 0 || life <= 0.0) // emit: dead particles respawn at the emitter
+	{
+		uint h = index * 1664525u + uint(u_Time * 1000.0) * 1013904223u;
+		float angle = Hash(h) * 6.2831853;
+		float speed = 40.0 + Hash(h + 1u) * 260.0;
+
+		position = u_Emitter;
+		velocity = vec2(cos(angle), sin(angle)) * speed + vec2(0.0, 120.0);
+		lifetime = 1.0 + Hash(h + 2u) * 3.0;
+		life     = lifetime;
+		seed     = Hash(h + 3u);
+		size     = 1.0 + seed * 3.0;
+	}
+
+	velocity += u_Gravity * u_DeltaTime;
+	position += velocity * u_DeltaTime;
+}
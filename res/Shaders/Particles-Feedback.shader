@@ -0,0 +1,27 @@
+#feedback o_Position o_Velocity o_Life o_Lifetime o_Seed o_Size
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec2  position;
+layout(location = 1) in vec2  velocity;
+layout(location = 2) in float life;
+layout(location = 3) in float lifetime;
+layout(location = 4) in float seed;
+layout(location = 5) in float size;
+
+// captured interleaved in `#feedback` order: same layout as `ParticleSystem::Particle`
+out vec2  o_Position;
+out vec2  o_Velocity;
+out float o_Life;
+out float o_Lifetime;
+out float o_Seed;
+out float o_Size;
+
+#include "Particles-Common.glsl"
+
+void main()
+{
+	o_Position = position; o_Velocity = velocity;
+	o_Life = life; o_Lifetime = lifetime; o_Seed = seed; o_Size = size;
+	Simulate(uint(gl_VertexID), o_Position, o_Velocity, o_Life, o_Lifetime, o_Seed, o_Size);
+}
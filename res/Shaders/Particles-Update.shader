@@ -0,0 +1,29 @@
+#shader compute
+#version 430 core
+
+layout(local_size_x = 256) in;
+
+struct Particle // matches `ParticleSystem::Particle`
+{
+	vec2  position;
+	vec2  velocity;
+	float life;
+	float lifetime;
+	float seed;
+	float size;
+};
+layout(std430, binding = 0) buffer Particles { Particle particles[]; };
+
+uniform int u_Count;
+
+#include "Particles-Common.glsl"
+
+void main()
+{
+	uint index = gl_GlobalInvocationID.x;
+	if (index >= uint(u_Count)) return;
+
+	Particle p = particles[index];
+	Simulate(index, p.position, p.velocity, p.life, p.lifetime, p.seed, p.size);
+	particles[index] = p;
+}
@@ -0,0 +1,34 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec2  position;
+layout(location = 1) in vec2  velocity;
+layout(location = 2) in float life;
+layout(location = 3) in float lifetime;
+layout(location = 4) in float seed;
+layout(location = 5) in float size;
+
+uniform mat4 u_MVP;
+out     vec4 v_Color;
+
+void main()
+{
+	float age = 1.0 - clamp(life / max(lifetime, 0.001), 0.0, 1.0);
+	gl_Position  = u_MVP * vec4(position, 0.0, 1.0);
+	gl_PointSize = life > 0.0 ? size : 0.0;
+	v_Color = vec4(mix(vec3(1.0, 0.8, 0.3), vec3(0.9, 0.2, 0.1 + seed * 0.5), age), 1.0 - age);
+}
+
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+
+void main()
+{
+	vec2 coord = gl_PointCoord * 2.0 - 1.0; // round points
+	color = vec4(v_Color.rgb, v_Color.a * max(1.0 - dot(coord, coord), 0.0));
+}
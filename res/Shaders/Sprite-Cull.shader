@@ -0,0 +1,37 @@
+#shader compute
+#version 430 core
+
+layout(local_size_x = 256) in;
+
+struct Sprite // matches `SpriteCuller::Sprite`
+{
+	vec2 position; // bottom-left corner
+	vec2 size;
+	vec4 color;
+};
+layout(std430, binding = 0) readonly  buffer Sprites { Sprite sprites[]; };
+layout(std430, binding = 1) writeonly buffer Visible { Sprite visible[]; };
+layout(std430, binding = 2) buffer Command // `DrawElementsIndirectCommand`, `instanceCount` reset to 0 before the dispatch
+{
+	uint count;
+	uint instanceCount;
+	uint firstIndex;
+	int  baseVertex;
+	uint baseInstance;
+} command;
+
+uniform int  u_Count;
+uniform vec2 u_ViewMin;
+uniform vec2 u_ViewMax;
+
+void main()
+{
+	uint index = gl_GlobalInvocationID.x;
+	if (index >= uint(u_Count)) return;
+
+	Sprite sprite = sprites[index];
+	if (any(greaterThan(sprite.position, u_ViewMax)) || any(lessThan(sprite.position + sprite.size, u_ViewMin)))
+		return;
+
+	visible[atomicAdd(command.instanceCount, 1u)] = sprite; // append: the draw's instance count is the number of survivors
+}
@@ -0,0 +1,29 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec2 corner;   // unit quad, per vertex
+layout(location = 1) in vec2 position; // per instance
+layout(location = 2) in vec2 size;
+layout(location = 3) in vec4 color;
+
+uniform mat4 u_MVP;
+out     vec4 v_Color;
+
+void main()
+{
+	gl_Position = u_MVP * vec4(position + corner * size, 0.0, 1.0);
+	v_Color = color;
+}
+
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+
+void main()
+{
+	color = v_Color;
+}
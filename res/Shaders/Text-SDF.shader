@@ -0,0 +1,46 @@
+#shader vertex
+#version 330 core
+
+// same vertex layout as `Batch-Textures.shader`: text quads share the sprite batch path
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec4 color;
+layout(location = 2) in vec2 texcoord;
+layout(location = 3) in float texidx;
+
+uniform mat4 u_MVP;
+out     vec4 v_Color;
+out     vec2 v_TexCoord;
+out     float v_TexIndex;
+
+void main()
+{
+	gl_Position = u_MVP * position;
+	v_Color = color;
+	v_TexCoord = texcoord;
+	v_TexIndex = texidx;
+}
+
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+uniform sampler2D u_Textures[MAX_TEXTURES]; // single-channel distance atlases, one per font
+uniform float u_Softness;                   // edge width in screen pixels (~0.7 - crisp, larger - blurred)
+in vec4 v_Color;
+in vec2 v_TexCoord;
+in float v_TexIndex;
+
+void main()
+{
+	int index = int(v_TexIndex);
+	vec4 sdf = vec4(0.0);
+	SAMPLE_TEXTURES(u_Textures, index, v_TexCoord, sdf)
+
+	// 0.5 is the glyph outline; `fwidth` keeps the edge one screen pixel wide at any scale
+	float distance = sdf.r;
+	float width = max(fwidth(distance) * u_Softness, 1e-4);
+	float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+	color = vec4(v_Color.rgb, v_Color.a * alpha);
+}
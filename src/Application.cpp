@@ -1,5 +1,10 @@
 #include "Utility.hpp"
 #include "Renderer.hpp"
+#include "FrameTimer.hpp"
+#include "FrameCapture.hpp"
+#include "SimulationThread.hpp"
+#include "Assets.hpp"
+#include "GpuMemory.hpp"
 
 #include "tests/Test.hpp"
 #include "tests/Test-ClearColor.hpp"
@@ -7,6 +12,20 @@
 #include "tests/Test-Batching.hpp"
 #include "tests/Test-Batching-Textures.hpp"
 #include "tests/Test-Batching-Textures-dynamic.hpp"
+#include "tests/Test-Batching-Indirect.hpp"
+#include "tests/Test-Particles.hpp"
+#include "tests/Test-Sprite-Culling.hpp"
+#include "tests/Test-Spatial-Index.hpp"
+#include "tests/Test-Sprite-Pool.hpp"
+#include "tests/Test-Text.hpp"
+#include "tests/Test-Tilemap.hpp"
+#include "tests/Test-Render-Targets.hpp"
+#include "tests/Test-Sprite-Layers.hpp"
+#include "tests/Test-Transform-Hierarchy.hpp"
+#include "tests/Test-Mesh.hpp"
+#include "tests/Test-Threaded-Simulation.hpp"
+#include "tests/Test-Texture-Streaming.hpp"
+#include "tests/Test-Flipbook.hpp"
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
@@ -29,13 +48,14 @@ int main()
 	glfwWindowHint(GLFW_CONTEXT_DEBUG        , GLFW_TRUE);
 	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);                // 3.0+
 	glfwWindowHint(GLFW_OPENGL_PROFILE       , GLFW_OPENGL_CORE_PROFILE); // 3.2+
+	glfwWindowHint(GLFW_DEPTH_BITS           , 24);                       // depth-tested opaque sprites (`SpriteBatch`)
 
 	GLFWwindow *window = glfwCreateWindow(960, 540, "ChernoOpenGL", nullptr, nullptr);
 	if (!window)
 	{ glfwTerminate(); return -1; }
 
 	glfwMakeContextCurrent(window);
-	glfwSwapInterval(1);
+	// swap interval is managed by `FrameTimer` (vsync/uncapped/limited)
 
 	// Init GLEW (run-time OpenGL extensions loader)
 	if (GLenum err = glewInit(); err != GLEW_OK)
@@ -85,6 +105,7 @@ int main()
 	std::cout << "Info: GLSL version: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << std::endl;
 	std::cout << "Info: GPU  vendor : " << glGetString(GL_VENDOR) << std::endl;
 	std::cout << "Info: Renderer    : " << glGetString(GL_RENDERER) << std::endl;
+	std::cout << "Info: GL: Direct State Access - " << (HasDSA() ? "active" : "inactive (GL 3.3 bind path)") << std::endl;
 	std::cout << "Info: ImGui version: " << IMGUI_VERSION;
 #ifdef IMGUI_HAS_DOCK
 	std::cout << " +docking";
@@ -96,6 +117,10 @@ int main()
 
 	{ // Vertex-/Index-Buffer scope
 		Renderer renderer;
+		FrameTimer frameTimer;
+		FrameCapture frameCapture; // PBO readback: screenshots/recording without stalling the frame
+		SimulationThread simulation; // `OnUpdate` of tests that support it, overlapping with rendering
+		bool threadedSimulation = false;
 
 		test::Test *currentTest = nullptr;
 		test::TestMenu *testMenu = new test::TestMenu(currentTest);
@@ -107,10 +132,27 @@ int main()
 		testMenu->RegisterTest<test::BatchingTextures>("Batching Textures");
 		if (glEnableVertexArrayAttrib)
 			testMenu->RegisterTest<test::BatchingTexturesDynamic>("Batching Textures (dynamic)");
+		testMenu->RegisterTest<test::BatchingIndirect>("Batching Indirect");
+		testMenu->RegisterTest<test::Particles>("Particles (GPU)");
+		testMenu->RegisterTest<test::SpriteCulling>("Sprite Culling");
+		testMenu->RegisterTest<test::SpatialIndexBenchmark>("Spatial Index");
+		testMenu->RegisterTest<test::SpritePoolBenchmark>("Sprite Pool (SoA)");
+		testMenu->RegisterTest<test::TextRendering>("Text (SDF)");
+		testMenu->RegisterTest<test::TilemapChunks>("Tilemap (chunked)");
+		testMenu->RegisterTest<test::RenderTargets>("Render Targets (bloom)");
+		testMenu->RegisterTest<test::SpriteLayers>("Sprite Layers (opaque/translucent)");
+		testMenu->RegisterTest<test::TransformHierarchyBenchmark>("Transform Hierarchy");
+		testMenu->RegisterTest<test::MeshLoading>("Mesh (OBJ)");
+		testMenu->RegisterTest<test::ThreadedSimulation>("Threaded Simulation");
+		testMenu->RegisterTest<test::TextureStreaming>("Texture Streaming (PBO)");
+		testMenu->RegisterTest<test::FlipbookAnimation>("Flipbook Animation");
 
 		bool show_demo_window = false;
 		while (!glfwWindowShouldClose(window))
 		{
+			frameTimer.BeginFrame();
+			frameCapture.Poll(); // hands finished reads (2-3 frames old) to the encoder thread
+
 			GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
 			renderer.Clear();
 
@@ -120,13 +162,34 @@ int main()
 
 			if (currentTest)
 			{
-				currentTest->OnUpdate();
+				const bool threaded = threadedSimulation && currentTest->SupportsThreadedUpdate();
+				if (threaded && !simulation.IsRunning())
+					simulation.Start([test = currentTest](float step) { test->OnUpdate(step); }, frameTimer.GetFixedStep());
+				else if (!threaded && simulation.IsRunning())
+					simulation.Stop();
+
+				if (threaded)
+				{ // the simulation thread keeps its own clock, the accumulator is only drained
+					simulation.SetStep(frameTimer.GetFixedStep());
+					while (frameTimer.Step()) {}
+				}
+				else
+				{
+					while (frameTimer.Step())
+						currentTest->OnUpdate(frameTimer.GetFixedStep());
+					currentTest->OnInterpolate(frameTimer.GetAlpha());
+				}
 				currentTest->OnRender();
+				int width = 0, height = 0;
+				glfwGetFramebufferSize(window, &width, &height);
+				frameCapture.Capture(width, height, FrameCapture::Stage::scene);
 				ImGui::Begin("Test");
 				if (currentTest != testMenu && ImGui::Button("<-"))
 				{ // return to menu
+					simulation.Stop(); // joined before the test it updates goes away
 					delete currentTest;
 					currentTest = testMenu;
+					GpuMemory::Get().SetOwner(GpuMemory::s_defaultOwner);
 					// Dodge: GL_INVALID_VALUE error generated.
 					//        <program> handle does not refer to an object generated by OpenGL.
 					// on RenderPlatformWindowsDefault()->ImGui_ImplOpenGL3_RenderDrawData() which restores GL state after drawing: `glUseProgram(last_program);`
@@ -139,6 +202,14 @@ int main()
 			{ // Show a simple window that we create ourselves (use a Begin/End pair to created a named window)
 				ImGui::Checkbox("Demo Window", &show_demo_window);
 				ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+				frameTimer.OnImGuiRender();
+				ImGui::Checkbox("Threaded simulation", &threadedSimulation);
+				if (threadedSimulation && currentTest && !currentTest->SupportsThreadedUpdate())
+				{ ImGui::SameLine(); ImGui::TextDisabled("(not supported by this test)"); }
+				simulation.OnImGuiRender();
+				frameCapture.OnImGuiRender();
+				Assets::Get().OnImGuiRender();
+				GpuMemory::Get().OnImGuiRender();
 			}
 
 			if (show_demo_window) // Show the big demo window (documentation active samples)
@@ -153,15 +224,26 @@ int main()
 				glfwMakeContextCurrent(window);
 			}
 
+			{
+				int width = 0, height = 0;
+				glfwGetFramebufferSize(window, &width, &height);
+				frameCapture.Capture(width, height, FrameCapture::Stage::interface);
+			}
+			frameTimer.MarkWorkEnd(); // before the swap: a vsync wait isn't work
 			glfwSwapBuffers(window);
+			GpuMemory::Get().Update(); // budget: evicts idle cached assets, warns once if still over
+			frameTimer.EndFrame(); // pacing sleep goes before polling - input is sampled as late as possible
 			glfwPollEvents();
 
 		} // while (!glfwWindowShouldClose(window))
 
+		simulation.Stop();
 		if (currentTest != testMenu)
 			delete testMenu;
 		delete currentTest;
 
+		Assets::Get().Clear(); // release cached GL objects while the context is alive
+
 	} // Vertex-/Index-Buffer scope
 
 	ImGui_ImplOpenGL3_Shutdown();
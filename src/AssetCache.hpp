@@ -0,0 +1,209 @@
+#pragma once
+
+#include "Utility.hpp"
+
+#include <list>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <utility>
+#include <unordered_map>
+
+// Lightweight generational reference to a cached asset: stale handles (evicted slot reused) resolve to `nullptr`
+template<class T>
+struct Handle
+{
+	std::uint32_t index = 0;
+	std::uint32_t generation = 0; // 0 - null handle
+
+	bool IsValid() const { return generation != 0; }
+	bool operator==(const Handle &other) const { return index == other.index && generation == other.generation; }
+	bool operator!=(const Handle &other) const { return !(*this == other); }
+};
+
+// Deduplicating, reference-counted asset cache keyed by path (or any string)
+// unreferenced assets stay resident (LRU ordered) and are evicted only when GPU memory exceeds the budget
+// each asset is heap allocated once: pointers from `Get()` stay valid until that asset is evicted
+template<class T>
+class AssetCache
+{
+	struct Slot
+	{
+		std::unique_ptr<T> asset; // own allocation: `m_slots` growing never moves assets
+		std::string key;
+		std::uint32_t generation = 1;
+		std::uint32_t references = 0;
+		std::size_t bytes = 0;
+		typename std::list<std::uint32_t>::iterator lru; // valid while `references == 0`
+	};
+
+	std::vector<Slot> m_slots;
+	std::vector<std::uint32_t> m_freeSlots;
+	std::unordered_map<std::string, std::uint32_t> m_lookup;
+	std::list<std::uint32_t> m_lru; // unreferenced slots: front - most recently released
+
+	std::size_t m_budget = std::size_t(256) << 20;
+	std::size_t m_bytes = 0;
+	std::size_t m_hits = 0, m_misses = 0, m_evictions = 0;
+
+public:
+	AssetCache() {}
+	AssetCache(const AssetCache &) = delete;
+	AssetCache &operator=(const AssetCache &) = delete;
+	~AssetCache() { Clear(); }
+
+	// Returns a referenced handle, constructing `T(args...)` only on a cache miss
+	template<class... Args>
+	Handle<T> Acquire(const std::string &key, Args &&...args)
+	{
+		if (const auto found = m_lookup.find(key); found != m_lookup.end())
+		{
+			Slot &slot = m_slots[found->second];
+			if (slot.references++ == 0) m_lru.erase(slot.lru);
+			m_hits++;
+			return { found->second, slot.generation };
+		}
+
+		std::uint32_t index;
+		if (!m_freeSlots.empty()) { index = m_freeSlots.back(); m_freeSlots.pop_back(); }
+		else { index = std::uint32_t(m_slots.size()); m_slots.emplace_back(); }
+
+		Slot &slot = m_slots[index];
+		slot.asset = std::make_unique<T>(std::forward<Args>(args)...);
+		slot.key = key;
+		slot.references = 1;
+		slot.bytes = slot.asset->GetMemorySize();
+		m_bytes += slot.bytes;
+		m_lookup.emplace(key, index);
+		m_misses++;
+
+		Trim();
+		return { index, slot.generation };
+	}
+
+	void AddReference(Handle<T> handle)
+	{
+		if (Slot *slot = Resolve(handle))
+			if (slot->references++ == 0) m_lru.erase(slot->lru);
+	}
+
+	void Release(Handle<T> handle)
+	{
+		Slot *slot = Resolve(handle);
+		if (!slot) return;
+		ASSERT(slot->references > 0);
+
+		if (--slot->references == 0)
+		{
+			m_lru.push_front(handle.index);
+			slot->lru = m_lru.begin();
+			Trim();
+		}
+	}
+
+	T *Get(Handle<T> handle) const
+	{
+		const Slot *slot = Resolve(handle);
+		return slot ? slot->asset.get() : nullptr;
+	}
+
+	// Evict least recently used unreferenced assets until under budget (referenced assets are never evicted)
+	void Trim()
+	{
+		while (m_bytes > m_budget && !m_lru.empty())
+		{
+			Evict(m_lru.back());
+			m_lru.pop_back();
+		}
+	}
+
+	// Evict least recently used unreferenced assets until `bytes` are freed (or none is left), regardless of the budget
+	// returns the bytes freed - `GpuMemory` calls this when the global GPU budget is exceeded
+	std::size_t EvictUnreferenced(std::size_t bytes)
+	{
+		std::size_t freed = 0;
+		while (freed < bytes && !m_lru.empty())
+		{
+			freed += m_slots[m_lru.back()].bytes;
+			Evict(m_lru.back());
+			m_lru.pop_back();
+		}
+		return freed;
+	}
+
+	// Drop everything (call before the GL context goes away), outstanding handles become stale
+	void Clear()
+	{
+		for (std::uint32_t i = 0; i < m_slots.size(); i++)
+			if (m_slots[i].asset) Evict(i);
+		m_lru.clear();
+	}
+
+	void SetBudget(std::size_t bytes) { m_budget = bytes; Trim(); }
+	std::size_t GetBudget() const { return m_budget; }
+	std::size_t GetBytes() const { return m_bytes; }
+	std::size_t GetCount() const { return m_lookup.size(); }
+	std::size_t GetUnreferencedCount() const { return m_lru.size(); }
+	std::size_t GetHits() const { return m_hits; }
+	std::size_t GetMisses() const { return m_misses; }
+	std::size_t GetEvictions() const { return m_evictions; }
+
+private:
+	const Slot *Resolve(Handle<T> handle) const
+	{
+		if (!handle.IsValid() || handle.index >= m_slots.size()) return nullptr;
+		const Slot &slot = m_slots[handle.index];
+		return slot.generation == handle.generation && slot.asset ? &slot : nullptr;
+	}
+	Slot *Resolve(Handle<T> handle) { return const_cast<Slot *>(std::as_const(*this).Resolve(handle)); }
+
+	void Evict(std::uint32_t index)
+	{
+		Slot &slot = m_slots[index];
+		m_lookup.erase(slot.key);
+		m_bytes -= slot.bytes;
+		slot.asset.reset();
+		slot.key.clear();
+		slot.references = 0;
+		slot.bytes = 0;
+		if (++slot.generation == 0) slot.generation = 1; // skip the null generation on wrap-around
+		m_freeSlots.push_back(index);
+		m_evictions++;
+	}
+};
+
+// RAII owner of one reference: copy adds a reference, destruction releases it
+template<class T>
+class AssetRef
+{
+	AssetCache<T> *m_cache = nullptr;
+	Handle<T> m_handle;
+
+public:
+	AssetRef() {}
+	AssetRef(AssetCache<T> &cache, Handle<T> handle) : m_cache(&cache), m_handle(handle) {} // adopts the reference of `Acquire()`
+	~AssetRef() { Reset(); }
+
+	AssetRef(const AssetRef &other) : m_cache(other.m_cache), m_handle(other.m_handle) { if (m_cache) m_cache->AddReference(m_handle); }
+	AssetRef(AssetRef &&other) noexcept : m_cache(std::exchange(other.m_cache, nullptr)), m_handle(std::exchange(other.m_handle, {})) {}
+	AssetRef &operator=(AssetRef other) noexcept
+	{
+		std::swap(m_cache, other.m_cache);
+		std::swap(m_handle, other.m_handle);
+		return *this;
+	}
+
+	void Reset()
+	{
+		if (m_cache) m_cache->Release(m_handle);
+		m_cache = nullptr;
+		m_handle = {};
+	}
+
+	Handle<T> GetHandle() const { return m_handle; }
+	T *Get() const { return m_cache ? m_cache->Get(m_handle) : nullptr; }
+	T *operator->() const { return Get(); }
+	T &operator*() const { return *Get(); }
+	explicit operator bool() const { return Get() != nullptr; }
+};
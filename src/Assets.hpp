@@ -0,0 +1,66 @@
+#pragma once
+
+#include "AssetCache.hpp"
+#include "Texture.hpp"
+#include "Shader.hpp"
+#include "GpuMemory.hpp"
+
+#include <imgui/imgui.h>
+
+#include <string>
+#include <filesystem>
+
+// Process-wide asset caches: tests share textures/shaders, so switching tests doesn't re-decode or re-upload
+class Assets
+{
+	AssetCache<Texture> m_textures;
+	AssetCache<Shader> m_shaders;
+
+public:
+	static Assets &Get() { static Assets instance; return instance; }
+
+	static AssetRef<Texture> LoadTexture(const std::filesystem::path &path)
+	{
+		AssetCache<Texture> &cache = Get().m_textures;
+		GpuMemory::OwnerScope owner("Assets"); // shared across tests
+		return { cache, cache.Acquire(GetKey(path), path) };
+	}
+	// Each define set is its own variant, keyed `<path>#<canonical defines>`
+	static AssetRef<Shader> LoadShader(const std::filesystem::path &path, const ShaderDefines &defines = {})
+	{
+		AssetCache<Shader> &cache = Get().m_shaders;
+		std::string key = GetKey(path);
+		if (!defines.empty()) key += '#' + Shader::GetDefinesKey(defines);
+		return { cache, cache.Acquire(key, path, defines) };
+	}
+
+	AssetCache<Texture> &GetTextures() { return m_textures; }
+	AssetCache<Shader> &GetShaders() { return m_shaders; }
+
+	// Must be called while the GL context is still alive
+	void Clear()
+	{
+		m_textures.Clear();
+		m_shaders.Clear();
+	}
+
+	void OnImGuiRender()
+	{
+		int budgetMiB = int(m_textures.GetBudget() >> 20);
+		if (ImGui::SliderInt("Texture budget (MiB)", &budgetMiB, 0, 1024))
+			m_textures.SetBudget(std::size_t(budgetMiB) << 20);
+		ImGui::Text("Textures: %zu (%zu idle) %.2f MiB, hits %zu, misses %zu, evictions %zu",
+			m_textures.GetCount(), m_textures.GetUnreferencedCount(), double(m_textures.GetBytes()) / (1 << 20),
+			m_textures.GetHits(), m_textures.GetMisses(), m_textures.GetEvictions());
+		ImGui::Text("Shaders: %zu (%zu idle), hits %zu, misses %zu",
+			m_shaders.GetCount(), m_shaders.GetUnreferencedCount(), m_shaders.GetHits(), m_shaders.GetMisses());
+	}
+
+private:
+	Assets()
+	{ // unreferenced textures are the first thing to go over the GPU budget
+		GpuMemory::Get().AddEvictCallback("Textures", [this](std::size_t bytes) { return m_textures.EvictUnreferenced(bytes); });
+	}
+
+	static std::string GetKey(const std::filesystem::path &path) { return path.lexically_normal().generic_string(); }
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstdint>
+
+// 2D orthographic camera: view, projection and their product are cached and recomputed only after a setter changed
+// them; `GetVersion()` changes with every recomputation, so callers can cache products like `viewProjection * model` too
+class Camera
+{
+	float m_left, m_right, m_bottom, m_top, m_near, m_far;
+	glm::vec2 m_position = glm::vec2(0.0f); // world point at the view's origin (bottom-left for a `0..w, 0..h` projection)
+	float m_rotation = 0.0f;                // radians
+	float m_zoom = 1.0f;
+
+	mutable glm::mat4 m_projection = glm::mat4(1.0f), m_view = glm::mat4(1.0f), m_viewProjection = glm::mat4(1.0f);
+	mutable bool m_projectionDirty = true, m_viewDirty = true;
+	mutable std::uint64_t m_version = 0;
+
+public:
+	Camera(float left, float right, float bottom, float top, float zNear = -1.0f, float zFar = 1.0f)
+		: m_left(left), m_right(right), m_bottom(bottom), m_top(top), m_near(zNear), m_far(zFar) {}
+
+	void SetProjection(float left, float right, float bottom, float top, float zNear = -1.0f, float zFar = 1.0f)
+	{
+		m_left = left; m_right = right; m_bottom = bottom; m_top = top; m_near = zNear; m_far = zFar;
+		m_projectionDirty = true;
+	}
+	// Setters compare first: writing the same value every frame keeps the cache
+	void SetPosition(const glm::vec2 &position) { if (position != m_position) { m_position = position; m_viewDirty = true; } }
+	void SetRotation(float rotation) { if (rotation != m_rotation) { m_rotation = rotation; m_viewDirty = true; } }
+	void SetZoom(float zoom) { if (zoom != m_zoom) { m_zoom = zoom; m_viewDirty = true; } }
+
+	const glm::vec2 &GetPosition() const { return m_position; }
+	float GetRotation() const { return m_rotation; }
+	float GetZoom() const { return m_zoom; }
+	// World size of the visible area
+	glm::vec2 GetViewSize() const { return glm::vec2(m_right - m_left, m_top - m_bottom) / m_zoom; }
+
+	const glm::mat4 &GetProjection() const { Refresh(); return m_projection; }
+	const glm::mat4 &GetView() const { Refresh(); return m_view; }
+	const glm::mat4 &GetViewProjection() const { Refresh(); return m_viewProjection; }
+	std::uint64_t GetVersion() const { Refresh(); return m_version; }
+
+private:
+	void Refresh() const
+	{
+		if (!m_projectionDirty && !m_viewDirty) return;
+		if (m_projectionDirty) m_projection = glm::ortho(m_left, m_right, m_bottom, m_top, m_near, m_far);
+		if (m_viewDirty) // zoom and rotate around the view's origin, then move the world under it
+			m_view = glm::scale(glm::mat4(1.0f), glm::vec3(m_zoom, m_zoom, 1.0f))
+				* glm::rotate(glm::mat4(1.0f), -m_rotation, glm::vec3(0.0f, 0.0f, 1.0f))
+				* glm::translate(glm::mat4(1.0f), glm::vec3(-m_position, 0.0f));
+		m_viewProjection = m_projection * m_view;
+		m_projectionDirty = m_viewDirty = false;
+		m_version++;
+	}
+};
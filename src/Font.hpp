@@ -0,0 +1,153 @@
+#pragma once
+
+#include "Utility.hpp"
+#include "Resources.hpp"
+#include "Texture.hpp"
+
+#include <stb/stb_truetype.h>
+#include <GL/glew.h>
+
+#include <array>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+
+// TrueType font baked once into a single-channel signed-distance-field atlas (printable ASCII)
+// one bake scales to any size: the shader thresholds the distance at 0.5 instead of sampling coverage
+// metrics are in bake pixels (y-up from the baseline), multiply by `size / GetBakeSize()` to lay out at `size`
+class Font
+{
+public:
+	static constexpr int s_firstCodepoint = 32, s_lastCodepoint = 126;
+	static constexpr int s_glyphCount = s_lastCodepoint - s_firstCodepoint + 1;
+	static constexpr int s_atlasWidth = 512;
+
+	struct Glyph
+	{
+		float x0 = 0.0f, y0 = 0.0f, x1 = 0.0f, y1 = 0.0f; // quad relative to the pen position
+		float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f; // atlas rectangle (`0` - bottom-left corner)
+		float advance = 0.0f;
+		bool visible = false; // whitespace has no quad
+	};
+
+private:
+	Texture m_atlas;
+	std::array<Glyph, s_glyphCount> m_glyphs;
+	std::vector<float> m_kerning; // `s_glyphCount^2`, [left * s_glyphCount + right]
+	float m_bakeSize = 0.0f;
+	float m_ascent = 0.0f, m_descent = 0.0f, m_lineHeight = 0.0f;
+	bool m_loaded = false;
+
+public:
+	Font() {} // empty, move-assign a real one later
+	// `padding` - distance range in bake pixels on each side of the outline (wider - softer glows/outlines possible)
+	Font(const std::filesystem::path &path, float bakeSize = 32.0f, int padding = 4) : m_bakeSize(bakeSize)
+	{
+		const Resource file = Resources::Get().Load(path);
+		if (!file)
+		{
+			std::cerr << "Error: Fail to open font: " << path << std::endl;
+			return;
+		}
+
+		stbtt_fontinfo info;
+		if (!stbtt_InitFont(&info, file.GetData(), stbtt_GetFontOffsetForIndex(file.GetData(), 0)))
+		{
+			std::cerr << "Error: Fail to load font: " << path << std::endl;
+			return;
+		}
+
+		const float scale = stbtt_ScaleForPixelHeight(&info, bakeSize);
+		int ascent = 0, descent = 0, lineGap = 0;
+		stbtt_GetFontVMetrics(&info, &ascent, &descent, &lineGap);
+		m_ascent = float(ascent) * scale;
+		m_descent = float(descent) * scale;
+		m_lineHeight = float(ascent - descent + lineGap) * scale;
+
+		m_kerning.resize(std::size_t(s_glyphCount) * s_glyphCount);
+		for (int left = 0; left < s_glyphCount; left++)
+			for (int right = 0; right < s_glyphCount; right++)
+				m_kerning[std::size_t(left) * s_glyphCount + right] =
+					float(stbtt_GetCodepointKernAdvance(&info, s_firstCodepoint + left, s_firstCodepoint + right)) * scale;
+
+		Bake(info, scale, padding);
+		m_loaded = true;
+	}
+
+	// Codepoints outside the baked range map to '?'
+	const Glyph &GetGlyph(int codepoint) const { return m_glyphs[GetIndex(codepoint)]; }
+	float GetKerning(int left, int right) const { return m_kerning[std::size_t(GetIndex(left)) * s_glyphCount + GetIndex(right)]; }
+
+	const Texture &GetAtlas() const { return m_atlas; }
+	float GetBakeSize() const { return m_bakeSize; }
+	float GetAscent() const { return m_ascent; }
+	float GetDescent() const { return m_descent; }
+	float GetLineHeight() const { return m_lineHeight; }
+	bool IsLoaded() const { return m_loaded; }
+
+private:
+	static int GetIndex(int codepoint)
+	{
+		if (codepoint < s_firstCodepoint || codepoint > s_lastCodepoint) codepoint = '?';
+		return codepoint - s_firstCodepoint;
+	}
+
+	// Shelf packing in codepoint order: glyphs are similar in height, so the waste stays small
+	void Bake(const stbtt_fontinfo &info, float scale, int padding)
+	{
+		struct Bitmap { unsigned char *pixels; int width, height, x, y; };
+		std::array<Bitmap, s_glyphCount> bitmaps{};
+
+		int penX = 0, penY = 0, shelfHeight = 0;
+		for (int i = 0; i < s_glyphCount; i++)
+		{
+			const int codepoint = s_firstCodepoint + i;
+			int advance = 0, bearing = 0, xoff = 0, yoff = 0;
+			stbtt_GetCodepointHMetrics(&info, codepoint, &advance, &bearing);
+
+			Bitmap &bitmap = bitmaps[i];
+			bitmap.pixels = stbtt_GetCodepointSDF(&info, scale, codepoint, padding, 128, 128.0f / float(padding), &bitmap.width, &bitmap.height, &xoff, &yoff);
+
+			Glyph &glyph = m_glyphs[i];
+			glyph.advance = float(advance) * scale;
+			if (!bitmap.pixels) continue;
+
+			if (penX + bitmap.width + 1 > s_atlasWidth) { penX = 0; penY += shelfHeight + 1; shelfHeight = 0; }
+			bitmap.x = penX;
+			bitmap.y = penY;
+			penX += bitmap.width + 1; // 1 texel gutter: no bleeding under bilinear filtering
+			shelfHeight = std::max(shelfHeight, bitmap.height);
+
+			glyph.visible = true;
+			glyph.x0 = float(xoff);                  // stb offsets are y-down from the baseline
+			glyph.x1 = float(xoff + bitmap.width);
+			glyph.y0 = -float(yoff + bitmap.height);
+			glyph.y1 = -float(yoff);
+		}
+
+		int atlasHeight = 1;
+		while (atlasHeight < penY + shelfHeight) atlasHeight *= 2;
+
+		// bitmap rows are stored top-down as uploaded: row `y` of the atlas sits at `v = y / height`
+		std::vector<unsigned char> pixels(std::size_t(s_atlasWidth) * atlasHeight, 0);
+		for (int i = 0; i < s_glyphCount; i++)
+		{
+			const Bitmap &bitmap = bitmaps[i];
+			if (!bitmap.pixels) continue;
+
+			for (int row = 0; row < bitmap.height; row++)
+				std::copy_n(bitmap.pixels + std::size_t(row) * bitmap.width, bitmap.width, pixels.begin() + std::ptrdiff_t(std::size_t(bitmap.y + row) * s_atlasWidth + bitmap.x));
+			stbtt_FreeSDF(bitmap.pixels, nullptr);
+
+			Glyph &glyph = m_glyphs[i];
+			glyph.u0 = float(bitmap.x) / float(s_atlasWidth);
+			glyph.u1 = float(bitmap.x + bitmap.width) / float(s_atlasWidth);
+			glyph.v0 = float(bitmap.y + bitmap.height) / float(atlasHeight); // glyph bottom
+			glyph.v1 = float(bitmap.y) / float(atlasHeight);                 // glyph top
+		}
+
+		m_atlas = Texture(s_atlasWidth, atlasHeight, GL_R8, GL_RED, pixels.data());
+		std::cout << "Info: Font: baked " << s_glyphCount << " SDF glyphs at " << m_bakeSize << "px into " << s_atlasWidth << 'x' << atlasHeight << std::endl;
+	}
+};
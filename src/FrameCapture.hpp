@@ -0,0 +1,343 @@
+#pragma once
+
+#include "Utility.hpp"
+#include "GpuMemory.hpp"
+
+#include <stb/stb_image_write.h>
+#include <GL/glew.h>
+#include <imgui/imgui.h>
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+#include <condition_variable>
+
+// Asynchronous framebuffer readback: `glReadPixels` into a ring of pixel-pack buffers, each fenced; a buffer is mapped
+// only once its fence has signaled (2-3 frames later), so the CPU never waits for the GPU. Mapped frames are handed
+// to a worker thread that encodes them (PNG files, or one raw RGBA stream for `ffmpeg -f rawvideo`).
+// when every ring slot is still in flight or the encoder lags behind, frames are dropped instead of stalling
+class FrameCapture
+{
+public:
+	enum class Encoding : int { png = 0, raw = 1 };
+	enum class Stage : int { scene = 0, interface = 1 }; // read before or after ImGui is drawn
+
+	static constexpr int s_ringSize = 3;
+	static constexpr std::size_t s_maxPendingJobs = 8; // frames waiting for the encoder (~2 MB each at 960x540)
+
+private:
+	struct Slot
+	{
+		unsigned int buffer = 0;
+		GLsync fence = nullptr; // set - read in flight
+		int width = 0, height = 0;
+		std::size_t capacity = 0; // bytes
+		std::uint64_t frame = 0;
+		std::filesystem::path path;
+		Encoding encoding = Encoding::png;
+	};
+	struct Job
+	{
+		std::vector<unsigned char> pixels; // top-down RGBA
+		int width = 0, height = 0;
+		std::filesystem::path path;
+		Encoding encoding = Encoding::png;
+		bool endOfStream = false; // no pixels: flush and close the raw stream
+	};
+
+	Slot m_slots[s_ringSize];
+	int m_head = 0; // next slot to write, also the oldest in flight
+	std::uint64_t m_frame = 0;
+
+	// requests (main thread)
+	Stage m_stage = Stage::scene;
+	Encoding m_encoding = Encoding::raw;
+	int m_interval = 1; // record every n-th frame
+	bool m_recording = false;
+	bool m_screenshot = false;
+	int m_session = 0;
+	std::filesystem::path m_directory = "captures";
+	std::size_t m_captured = 0, m_dropped = 0;
+	std::uint64_t m_latency = 0; // frames between read and delivery
+
+	// worker
+	std::thread m_worker;
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::deque<Job> m_jobs;
+	std::vector<std::vector<unsigned char>> m_freeBuffers; // recycled pixel storage
+	bool m_stop = false;
+	std::atomic<std::size_t> m_written{ 0 };
+	std::atomic<float> m_encodeMilliseconds{ 0.0f };
+
+public:
+	FrameCapture() : m_worker([this] { Work(); }) {}
+	~FrameCapture()
+	{
+		Drain(); // deliver what is still in flight: the end of a recording isn't lost
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_wake.notify_one();
+		m_worker.join(); // encodes the remaining jobs first
+
+		for (Slot &slot : m_slots)
+		{
+			GpuMemory::Get().Free(GpuMemory::Object::buffer, slot.buffer);
+			GLCall(glDeleteBuffers(1, &slot.buffer));
+		}
+	}
+
+	FrameCapture(const FrameCapture &) = delete;
+	FrameCapture &operator=(const FrameCapture &) = delete;
+
+	// Call once per frame (any time): delivers finished reads without waiting
+	void Poll()
+	{
+		m_frame++;
+		for (int i = 0; i < s_ringSize; i++) // oldest first: the raw stream stays in frame order
+		{
+			Slot &slot = m_slots[(m_head + i) % s_ringSize];
+			if (!slot.fence) continue;
+
+			GLenum status = GL_TIMEOUT_EXPIRED;
+			GLCall(status = glClientWaitSync(slot.fence, 0, 0)); // timeout 0: a query, never a wait
+			if (status == GL_TIMEOUT_EXPIRED) break;
+			if (status == GL_WAIT_FAILED) { Discard(slot); continue; }
+			Deliver(slot);
+		}
+	}
+
+	// Reads the current framebuffer (`width x height`) when a capture is due and `stage` is the selected one
+	void Capture(int width, int height, Stage stage)
+	{
+		if (stage != m_stage || width <= 0 || height <= 0) return;
+		const bool recordFrame = m_recording && m_frame % std::uint64_t(m_interval) == 0;
+		if (!m_screenshot && !recordFrame) return;
+
+		Slot &slot = m_slots[m_head];
+		if (slot.fence) { m_dropped++; return; } // ring full: the GPU is more than `s_ringSize` frames behind
+
+		const std::size_t size = std::size_t(width) * height * 4;
+		if (size > slot.capacity)
+		{
+			GpuMemory::Get().Free(GpuMemory::Object::buffer, slot.buffer);
+			GLCall(glDeleteBuffers(1, &slot.buffer));
+			GLCall(glGenBuffers(1, &slot.buffer));
+			GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer));
+			GLCall(glBufferData(GL_PIXEL_PACK_BUFFER, GLsizeiptr(size), nullptr, GL_STREAM_READ));
+			GpuMemory::Get().Allocate(GpuMemory::Object::buffer, slot.buffer, GpuMemory::Category::readback, size);
+			slot.capacity = size;
+		}
+
+		// `glReadPixels` has no DSA form: the pack buffer is bound either way, the pointer argument becomes an offset
+		GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer));
+		GLCall(glPixelStorei(GL_PACK_ALIGNMENT, 4));
+		GLCall(glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+		GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+		GLCall(slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+		slot.width = width;
+		slot.height = height;
+		slot.frame = m_frame;
+		if (m_screenshot)
+		{
+			slot.encoding = Encoding::png;
+			slot.path = m_directory / ("screenshot_" + std::to_string(m_session) + '_' + std::to_string(m_frame) + ".png");
+			m_screenshot = false;
+		}
+		else
+		{
+			slot.encoding = m_encoding;
+			slot.path = m_encoding == Encoding::png
+				? m_directory / ("recording_" + std::to_string(m_session) + '_' + std::to_string(m_frame) + ".png")
+				: m_directory / ("recording_" + std::to_string(m_session) + '_' + std::to_string(width) + 'x' + std::to_string(height) + ".rgba");
+		}
+		m_captured++;
+		m_head = (m_head + 1) % s_ringSize;
+	}
+
+	void TakeScreenshot() { Prepare(); m_screenshot = true; }
+	void StartRecording() { Prepare(); m_recording = true; }
+	void StopRecording()
+	{
+		m_recording = false;
+		Drain();
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			Job job;
+			job.endOfStream = true;
+			m_jobs.push_back(std::move(job)); // never dropped: the file must be complete once the queue is empty
+		}
+		m_wake.notify_one();
+	}
+	bool IsRecording() const { return m_recording; }
+
+	void OnImGuiRender()
+	{
+		if (!ImGui::CollapsingHeader("Frame capture")) return;
+
+		const char *stages[] = { "Scene only", "With interface" };
+		ImGui::Combo("Read", reinterpret_cast<int *>(&m_stage), stages, IM_ARRAYSIZE(stages));
+		const char *encodings[] = { "PNG sequence", "Raw RGBA stream" };
+		ImGui::BeginDisabled(m_recording);
+		ImGui::Combo("Encoding", reinterpret_cast<int *>(&m_encoding), encodings, IM_ARRAYSIZE(encodings));
+		ImGui::EndDisabled();
+		ImGui::SliderInt("Every n-th frame", &m_interval, 1, 10, "%d", ImGuiSliderFlags_AlwaysClamp); // 0 would divide by zero
+
+		if (ImGui::Button("Screenshot")) TakeScreenshot();
+		ImGui::SameLine();
+		if (ImGui::Button(m_recording ? "Stop recording" : "Start recording"))
+			m_recording ? StopRecording() : StartRecording();
+
+		std::size_t pending = 0;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			pending = m_jobs.size();
+		}
+		ImGui::Text("Captured %zu, written %zu, dropped %zu, encoder queue %zu", m_captured, m_written.load(), m_dropped, pending);
+		ImGui::Text("Delivery latency %llu frames, encode %.2f ms/frame", (unsigned long long)m_latency, double(m_encodeMilliseconds.load()));
+		if (m_encoding == Encoding::raw)
+			ImGui::TextDisabled("ffmpeg -f rawvideo -pix_fmt rgba -s WxH -i <file>.rgba out.mp4");
+	}
+
+private:
+	void Prepare()
+	{
+		if (m_recording || m_screenshot) return;
+		m_session++;
+		std::error_code error;
+		std::filesystem::create_directories(m_directory, error);
+		if (error) std::cerr << "Error: FrameCapture: can't create " << m_directory << ": " << error.message() << std::endl;
+	}
+
+	// Blocking: waits for every in-flight read (stop/shutdown only)
+	void Drain()
+	{
+		for (int i = 0; i < s_ringSize; i++)
+		{
+			Slot &slot = m_slots[(m_head + i) % s_ringSize];
+			if (!slot.fence) continue;
+			GLenum status = GL_WAIT_FAILED;
+			GLCall(status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000)); // 1 s
+			if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED)
+			{ // mapping now would block again (or read an incomplete frame)
+				std::cerr << "Warning: FrameCapture: frame " << slot.frame << (status == GL_WAIT_FAILED ? " read failed" : " read timed out") << ", dropped" << std::endl;
+				Discard(slot);
+				continue;
+			}
+			Deliver(slot);
+		}
+	}
+
+	void Discard(Slot &slot)
+	{
+		GLCall(glDeleteSync(slot.fence));
+		slot.fence = nullptr;
+		m_dropped++;
+	}
+
+	// Maps a finished read, copies it out flipped to top-down rows, queues it for the worker
+	void Deliver(Slot &slot)
+	{
+		GLCall(glDeleteSync(slot.fence));
+		slot.fence = nullptr;
+		m_latency = m_frame - slot.frame;
+
+		Job job;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_jobs.size() >= s_maxPendingJobs) { m_dropped++; return; } // encoder can't keep up
+			if (!m_freeBuffers.empty()) { job.pixels = std::move(m_freeBuffers.back()); m_freeBuffers.pop_back(); }
+		}
+
+		const std::size_t stride = std::size_t(slot.width) * 4;
+		job.pixels.resize(stride * slot.height);
+		GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer));
+		const unsigned char *mapped = nullptr;
+		GLCall(mapped = static_cast<const unsigned char *>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, GLsizeiptr(stride * slot.height), GL_MAP_READ_BIT)));
+		if (mapped)
+		{
+			for (int row = 0; row < slot.height; row++) // GL rows start at the bottom
+				std::memcpy(job.pixels.data() + std::size_t(row) * stride, mapped + std::size_t(slot.height - 1 - row) * stride, stride);
+			GLCall(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+		}
+		GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+		if (!mapped) return;
+
+		job.width = slot.width;
+		job.height = slot.height;
+		job.path = slot.path;
+		job.encoding = slot.encoding;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_jobs.push_back(std::move(job));
+		}
+		m_wake.notify_one();
+	}
+
+	// Worker thread: encodes until stopped and the queue is empty
+	void Work()
+	{
+		std::ofstream stream; // raw recordings: every frame appended to one file
+		std::filesystem::path streamPath;
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (true)
+		{
+			m_wake.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+			if (m_jobs.empty()) return; // stopped and drained
+
+			Job job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+			lock.unlock();
+
+			if (job.endOfStream)
+			{
+				if (stream.is_open())
+				{
+					stream.flush();
+					if (!stream) std::cerr << "Error: FrameCapture: fail to write " << streamPath << std::endl;
+					stream.close();
+				}
+				streamPath.clear();
+				lock.lock();
+				continue;
+			}
+
+			const auto start = std::chrono::steady_clock::now();
+			if (job.encoding == Encoding::png)
+			{
+				if (!stbi_write_png(job.path.string().c_str(), job.width, job.height, 4, job.pixels.data(), job.width * 4))
+					std::cerr << "Error: FrameCapture: fail to write " << job.path << std::endl;
+			}
+			else
+			{
+				if (job.path != streamPath)
+				{
+					stream = std::ofstream(job.path, std::ios::binary | std::ios::app);
+					streamPath = job.path;
+					if (!stream) std::cerr << "Error: FrameCapture: fail to open " << job.path << std::endl;
+				}
+				stream.write(reinterpret_cast<const char *>(job.pixels.data()), std::streamsize(job.pixels.size()));
+			}
+			const float milliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+			const float average = m_encodeMilliseconds.load();
+			m_encodeMilliseconds.store(Smooth(average, milliseconds));
+			m_written++;
+
+			lock.lock();
+			m_freeBuffers.push_back(std::move(job.pixels));
+		}
+	}
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Lock-free snapshot handoff between one writer (simulation) and one reader (render) thread - triple buffering:
+// the writer fills its own slot and `Publish()`es it, the reader `Acquire()`s the newest published one; neither
+// ever waits on the other, snapshots published faster than they are read are skipped
+// after `Publish()` the write slot holds an older snapshot: overwrite it completely (or copy forward)
+template<class T>
+class FrameState
+{
+	static constexpr std::uint8_t s_index = 0x3, s_fresh = 0x4; // shared: slot index | "not yet acquired"
+
+	std::array<T, 3> m_slots;
+	std::atomic<std::uint8_t> m_shared{ 1 };
+	std::uint8_t m_write = 0; // writer thread only
+	std::uint8_t m_read = 2;  // reader thread only
+
+public:
+	FrameState() {}
+	FrameState(const FrameState &) = delete;
+	FrameState &operator=(const FrameState &) = delete;
+
+	// Writer
+	T &GetWrite() { return m_slots[m_write]; }
+	void Publish() { m_write = m_shared.exchange(std::uint8_t(m_write | s_fresh), std::memory_order_acq_rel) & s_index; }
+
+	// Reader: swaps in the newest snapshot, returns `false` (keeping the current one) if nothing was published since
+	bool Acquire()
+	{
+		if (!(m_shared.load(std::memory_order_relaxed) & s_fresh)) return false;
+		m_read = m_shared.exchange(m_read, std::memory_order_acq_rel) & s_index;
+		return true;
+	}
+	const T &GetRead() const { return m_slots[m_read]; }
+
+	// Not thread-safe: before the threads start
+	std::array<T, 3> &GetSlots() { return m_slots; }
+};
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "Utility.hpp"
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <imgui/imgui.h>
+
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+// Frame pacing: high-resolution delta tracking, fixed-timestep accumulator and present policy (vsync/uncapped/limited)
+class FrameTimer
+{
+public:
+	enum class Mode : int { vsync = 0, uncapped = 1, limited = 2 };
+
+	using clock_t   = std::chrono::steady_clock;
+	using seconds_t = std::chrono::duration<double>;
+
+private:
+	Mode m_mode = Mode::vsync;
+	int  m_targetFps = 144;  // `Mode::limited` only
+	int  m_fixedRate = 120;  // simulation steps per second
+	bool m_lowLatency = false;
+
+	static constexpr int    s_maxStepsPerFrame = 8;    // "spiral of death" guard: drop simulation time instead
+	static constexpr double s_maxDelta         = 0.25; // clamp hitches (breakpoints, window drags)
+	static constexpr double s_spinThreshold    = 0.002; // below this - spin instead of `sleep_for` (OS timer granularity)
+
+	clock_t::time_point m_frameStart = clock_t::now();
+	clock_t::time_point m_deadline   = m_frameStart;
+	double m_delta = 0.0;       // last frame duration [s]
+	double m_accumulator = 0.0; // unsimulated time [s]
+	double m_workTime = 0.0;    // smoothed CPU time from `BeginFrame()` to `MarkWorkEnd()` [s], excludes the swap wait
+	int    m_steps = 0;         // fixed steps taken this frame
+	bool   m_applySwapInterval = true;
+
+public:
+	FrameTimer() {}
+
+	// Call once at the top of the main loop
+	void BeginFrame()
+	{
+		const auto now = clock_t::now();
+		m_delta = std::min(seconds_t(now - m_frameStart).count(), s_maxDelta);
+		m_frameStart = now;
+		m_accumulator += m_delta;
+		m_steps = 0;
+
+		if (m_applySwapInterval)
+		{
+			glfwSwapInterval(m_mode == Mode::vsync ? 1 : 0);
+			m_deadline = now;
+			m_applySwapInterval = false;
+		}
+	}
+
+	// Consume one fixed step from the accumulator, use as: `while (timer.Step()) test->OnUpdate(timer.GetFixedStep());`
+	bool Step()
+	{
+		const double step = GetFixedStep();
+		if (m_accumulator < step) return false;
+
+		if (m_steps == s_maxStepsPerFrame)
+		{ // can't keep up - drop the backlog (simulation slows down instead of stalling the frame)
+			m_accumulator = std::min(m_accumulator, step);
+			return false;
+		}
+
+		m_accumulator -= step;
+		m_steps++;
+		return true;
+	}
+
+	// Call right before `glfwSwapBuffers()`: with vsync the swap blocks, which must not count as work
+	void MarkWorkEnd()
+	{
+		m_workTime += (seconds_t(clock_t::now() - m_frameStart).count() - m_workTime) * 0.1; // exponential moving average
+	}
+
+	// Call right after `glfwSwapBuffers()` and before `glfwPollEvents()` - sleeping here delays input sampling to the last moment
+	void EndFrame()
+	{
+		const auto now = clock_t::now();
+
+		switch (m_mode)
+		{
+		case Mode::limited:
+		{
+			const auto period = std::chrono::duration_cast<clock_t::duration>(seconds_t(1.0 / m_targetFps));
+			m_deadline += period;
+			if (m_deadline < now - period) m_deadline = now; // fell behind: resync instead of bursting
+			SleepUntil(m_deadline);
+			break;
+		}
+		case Mode::vsync:
+			if (m_lowLatency)
+			{ // wait for the swap to really happen, then sleep away the predicted slack of the next refresh interval
+				GLCall(glFinish());
+				const double slack = GetRefreshPeriod() - m_workTime - s_spinThreshold;
+				if (slack > 0.0)
+					SleepUntil(clock_t::now() + std::chrono::duration_cast<clock_t::duration>(seconds_t(slack)));
+			}
+			break;
+		case Mode::uncapped:
+			break;
+		}
+	}
+
+	float GetDelta() const { return float(m_delta); }
+	float GetFixedStep() const { return 1.0f / float(m_fixedRate); }
+	float GetAlpha() const { return float(m_accumulator / GetFixedStep()); } // interpolation factor between last two simulated states [0, 1] (1 after dropping a backlog)
+	int   GetSteps() const { return m_steps; }
+
+	Mode GetMode() const { return m_mode; }
+	void SetMode(Mode mode) { m_mode = mode; m_applySwapInterval = true; }
+	void SetTargetFps(int fps) { m_targetFps = std::max(fps, 1); }
+	void SetFixedRate(int hz) { m_fixedRate = std::max(hz, 1); }
+	void SetLowLatency(bool enable) { m_lowLatency = enable; }
+
+	void OnImGuiRender()
+	{
+		static const char *const modes[] = { "VSync", "Uncapped", "Limited" };
+
+		int mode = static_cast<int>(m_mode);
+		if (ImGui::Combo("Present mode", &mode, modes, IM_ARRAYSIZE(modes)))
+			SetMode(static_cast<Mode>(mode));
+		if (m_mode == Mode::limited)
+			ImGui::SliderInt("Target FPS", &m_targetFps, 30, 1000, "%d", ImGuiSliderFlags_Logarithmic | ImGuiSliderFlags_AlwaysClamp);
+		if (m_mode == Mode::vsync)
+			ImGui::Checkbox("Low latency (sleep-then-poll)", &m_lowLatency);
+		ImGui::SliderInt("Fixed update (Hz)", &m_fixedRate, 10, 1000, "%d", ImGuiSliderFlags_Logarithmic | ImGuiSliderFlags_AlwaysClamp); // Ctrl+click input too
+		ImGui::Text("Frame %.3f ms, work %.3f ms, steps %d, alpha %.2f", m_delta * 1000.0, m_workTime * 1000.0, m_steps, GetAlpha());
+	}
+
+private:
+	static double GetRefreshPeriod()
+	{
+		if (GLFWmonitor *monitor = glfwGetPrimaryMonitor())
+			if (const GLFWvidmode *mode = glfwGetVideoMode(monitor); mode && mode->refreshRate > 0)
+				return 1.0 / mode->refreshRate;
+		return 1.0 / 60.0;
+	}
+
+	// Coarse OS sleep followed by a short spin - `sleep_for` alone overshoots by up to a scheduler quantum
+	static void SleepUntil(clock_t::time_point deadline)
+	{
+		const auto spin = std::chrono::duration_cast<clock_t::duration>(seconds_t(s_spinThreshold));
+		while (deadline - clock_t::now() > spin)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		while (clock_t::now() < deadline)
+			std::this_thread::yield();
+	}
+};
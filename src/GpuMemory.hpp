@@ -0,0 +1,242 @@
+#pragma once
+
+#include <imgui/imgui.h>
+
+#include <array>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+// Accounting of GPU storage created through the wrappers (`VertexBuffer`, `IndexBuffer`, `IndirectBuffer`, `Texture`,
+// `RenderTarget`, ...): live bytes and high-water marks per category and per owner, plus a budget
+// sizes are what was requested from GL - drivers add alignment/padding, so these are lower bounds
+// the owner is a scope name (`TestMenu` sets the running test, `Assets` its caches); GL thread only
+class GpuMemory
+{
+public:
+	enum class Object : std::uint32_t { buffer = 0, texture = 1 }; // separate GL name spaces
+	enum class Category : int { vertex = 0, index, indirect, texture, renderTarget, readback, upload, count };
+
+	struct Stats
+	{
+		std::size_t bytes = 0, peak = 0, count = 0;
+
+		void Add(std::size_t size) { bytes += size; count++; peak = std::max(peak, bytes); }
+		void Remove(std::size_t size) { bytes -= size; count--; }
+	};
+
+	// Called over budget with the bytes to free, returns the bytes it released (e.g. unreferenced cached assets)
+	using EvictCallback = std::function<std::size_t(std::size_t)>;
+
+	static constexpr const char *s_defaultOwner = "Application";
+
+private:
+	struct Allocation
+	{
+		Category category;
+		std::uint32_t owner;
+		std::size_t bytes;
+	};
+
+	std::unordered_map<std::uint64_t, Allocation> m_allocations; // `Object << 32 | GL name`
+	std::array<Stats, std::size_t(Category::count)> m_categories;
+	Stats m_total;
+	std::vector<std::string> m_ownerNames;
+	std::vector<Stats> m_owners;
+	std::uint32_t m_owner = 0;
+
+	std::vector<std::pair<std::string, EvictCallback>> m_evictCallbacks;
+	std::size_t m_budget = std::size_t(1) << 30;
+	std::size_t m_evicted = 0;
+	bool m_evict = true;
+	bool m_overBudget = false; // reported once per crossing
+
+public:
+	static GpuMemory &Get() { static GpuMemory instance; return instance; }
+
+	GpuMemory(const GpuMemory &) = delete;
+	GpuMemory &operator=(const GpuMemory &) = delete;
+
+	// Storage (re)specified for `name`: a re-specification replaces the previous size and keeps the original owner
+	void Allocate(Object object, unsigned int name, Category category, std::size_t bytes)
+	{
+		if (!name) return;
+		const std::uint64_t key = GetKey(object, name);
+		if (const auto found = m_allocations.find(key); found != m_allocations.end())
+		{
+			Remove(found->second);
+			found->second.category = category;
+			found->second.bytes = bytes;
+			Add(found->second);
+			return;
+		}
+		Add(m_allocations.emplace(key, Allocation{ category, m_owner, bytes }).first->second);
+	}
+	// Storage of `name` deleted (untracked names and `0` are ignored)
+	void Free(Object object, unsigned int name)
+	{
+		if (!name) return;
+		const auto found = m_allocations.find(GetKey(object, name));
+		if (found == m_allocations.end()) return;
+		Remove(found->second);
+		m_allocations.erase(found);
+	}
+
+	// Attribute following allocations to `owner` (until the next call)
+	void SetOwner(const std::string &owner) { m_owner = GetOwnerIndex(owner); }
+	const std::string &GetOwner() const { return m_ownerNames[m_owner]; }
+
+	// Temporarily attribute allocations to `owner`, the previous owner is restored on destruction
+	class OwnerScope
+	{
+		std::uint32_t m_previous;
+
+	public:
+		OwnerScope(const std::string &owner) : m_previous(Get().m_owner) { Get().SetOwner(owner); }
+		~OwnerScope() { Get().m_owner = m_previous; }
+		OwnerScope(const OwnerScope &) = delete;
+		OwnerScope &operator=(const OwnerScope &) = delete;
+	};
+
+	void AddEvictCallback(const std::string &name, EvictCallback callback) { m_evictCallbacks.emplace_back(name, std::move(callback)); }
+
+	// Once per frame: over budget, evict through the callbacks (in registration order), warn if that isn't enough
+	// not done inside `Allocate()` - the allocating wrapper may itself live in the cache being evicted
+	void Update()
+	{
+		if (m_total.bytes <= m_budget) { m_overBudget = false; return; }
+
+		std::size_t evicted = 0;
+		if (m_evict)
+			for (const auto &[name, callback] : m_evictCallbacks)
+			{
+				if (m_total.bytes <= m_budget) break;
+				evicted += callback(m_total.bytes - m_budget);
+			}
+		m_evicted += evicted;
+
+		if (m_total.bytes <= m_budget || m_overBudget) return;
+		m_overBudget = true;
+		std::cout << "Warning: GpuMemory: " << FormatMiB(m_total.bytes) << " MiB in use, over the " << FormatMiB(m_budget) << " MiB budget"
+			<< (evicted ? " after evicting " + FormatMiB(evicted) + " MiB" : std::string()) << ", largest owner: " << GetLargestOwner() << std::endl;
+	}
+
+	void SetBudget(std::size_t bytes) { m_budget = bytes; }
+	std::size_t GetBudget() const { return m_budget; }
+	void SetEvict(bool evict) { m_evict = evict; }
+	bool IsOverBudget() const { return m_total.bytes > m_budget; }
+
+	const Stats &GetTotal() const { return m_total; }
+	const Stats &GetCategory(Category category) const { return m_categories[std::size_t(category)]; }
+	std::size_t GetEvicted() const { return m_evicted; }
+
+	void ResetPeaks()
+	{
+		m_total.peak = m_total.bytes;
+		for (Stats &stats : m_categories) stats.peak = stats.bytes;
+		for (Stats &stats : m_owners) stats.peak = stats.bytes;
+	}
+
+	static const char *GetCategoryName(Category category)
+	{
+		static const char *const names[] = { "Vertex buffers", "Index buffers", "Indirect buffers", "Textures", "Render targets", "Readback buffers", "Upload buffers" };
+		static_assert(sizeof(names) / sizeof(*names) == std::size_t(Category::count));
+		return names[std::size_t(category)];
+	}
+
+	void OnImGuiRender()
+	{
+		if (!ImGui::CollapsingHeader("GPU memory")) return;
+
+		int budgetMiB = int(m_budget >> 20);
+		if (ImGui::SliderInt("GPU budget (MiB)", &budgetMiB, 16, 4096, "%d", ImGuiSliderFlags_Logarithmic))
+			m_budget = std::size_t(budgetMiB) << 20;
+		ImGui::Checkbox("Evict cached assets over budget", &m_evict);
+		ImGui::SameLine();
+		if (ImGui::Button("Reset peaks")) ResetPeaks();
+
+		const float used = m_budget ? float(double(m_total.bytes) / double(m_budget)) : 1.0f;
+		const std::string overlay = FormatMiB(m_total.bytes) + " / " + FormatMiB(m_budget) + " MiB";
+		if (used > 1.0f) ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.9f, 0.2f, 0.2f, 1.0f));
+		ImGui::ProgressBar(std::min(used, 1.0f), ImVec2(-1.0f, 0.0f), overlay.c_str());
+		if (used > 1.0f) ImGui::PopStyleColor();
+		ImGui::Text("Peak %s MiB, %zu allocations, evicted %s MiB total", FormatMiB(m_total.peak).c_str(), m_total.count, FormatMiB(m_evicted).c_str());
+
+		if (ImGui::BeginTable("GpuMemoryCategories", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingStretchProp))
+		{
+			SetupColumns("Category");
+			for (std::size_t i = 0; i < m_categories.size(); i++)
+				Row(GetCategoryName(Category(i)), m_categories[i]);
+			ImGui::EndTable();
+		}
+		if (ImGui::BeginTable("GpuMemoryOwners", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingStretchProp))
+		{
+			SetupColumns("Owner");
+			for (std::size_t i = 0; i < m_owners.size(); i++)
+				if (m_owners[i].peak) Row(m_ownerNames[i].c_str(), m_owners[i]);
+			ImGui::EndTable();
+		}
+	}
+
+private:
+	GpuMemory() { SetOwner(s_defaultOwner); }
+
+	static std::uint64_t GetKey(Object object, unsigned int name) { return std::uint64_t(object) << 32 | name; }
+	static std::string FormatMiB(std::size_t bytes)
+	{
+		char text[32];
+		std::snprintf(text, sizeof(text), "%.2f", double(bytes) / (1 << 20));
+		return text;
+	}
+
+	void Add(const Allocation &allocation)
+	{
+		m_total.Add(allocation.bytes);
+		m_categories[std::size_t(allocation.category)].Add(allocation.bytes);
+		m_owners[allocation.owner].Add(allocation.bytes);
+	}
+	void Remove(const Allocation &allocation)
+	{
+		m_total.Remove(allocation.bytes);
+		m_categories[std::size_t(allocation.category)].Remove(allocation.bytes);
+		m_owners[allocation.owner].Remove(allocation.bytes);
+	}
+
+	std::uint32_t GetOwnerIndex(const std::string &owner)
+	{
+		const auto found = std::find(m_ownerNames.begin(), m_ownerNames.end(), owner); // a handful of scopes
+		if (found != m_ownerNames.end()) return std::uint32_t(found - m_ownerNames.begin());
+		m_ownerNames.push_back(owner);
+		m_owners.emplace_back();
+		return std::uint32_t(m_ownerNames.size() - 1);
+	}
+
+	const std::string &GetLargestOwner() const
+	{
+		const auto largest = std::max_element(m_owners.begin(), m_owners.end(), [](const Stats &a, const Stats &b) { return a.bytes < b.bytes; });
+		return m_ownerNames[std::size_t(largest - m_owners.begin())];
+	}
+
+	static void SetupColumns(const char *first)
+	{
+		ImGui::TableSetupColumn(first);
+		ImGui::TableSetupColumn("Live MiB");
+		ImGui::TableSetupColumn("Peak MiB");
+		ImGui::TableSetupColumn("Count");
+		ImGui::TableHeadersRow();
+	}
+	static void Row(const char *name, const Stats &stats)
+	{
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn(); ImGui::TextUnformatted(name);
+		ImGui::TableNextColumn(); ImGui::Text("%.2f", double(stats.bytes) / (1 << 20));
+		ImGui::TableNextColumn(); ImGui::Text("%.2f", double(stats.peak) / (1 << 20));
+		ImGui::TableNextColumn(); ImGui::Text("%zu", stats.count);
+	}
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Utility.hpp"
+
+#include <GL/glew.h>
+
+#include <utility>
+
+// GPU time of the commands between `Begin()` and `End()` (`GL_TIME_ELAPSED`, core since GL 3.3)
+// results are read a few frames late from a ring of queries, so measuring never stalls the pipeline
+class GpuTimer
+{
+	static constexpr int s_latency = 4; // queries in flight
+
+	unsigned int m_queries[s_latency] = {};
+	int m_next = 0;    // query used by the next `Begin()`
+	int m_pending = 0; // ended, not yet read back
+	float m_milliseconds = 0.0f; // smoothed
+
+public:
+	GpuTimer() { GLCall(glGenQueries(s_latency, m_queries)); }
+	~GpuTimer() { GLCall(glDeleteQueries(s_latency, m_queries)); } // deleting `0` is a silent no-op
+
+	// Move-only: the GL names are owned by exactly one object
+	GpuTimer(const GpuTimer &) = delete;
+	GpuTimer &operator=(const GpuTimer &) = delete;
+	GpuTimer(GpuTimer &&other) noexcept { Swap(other); }
+	GpuTimer &operator=(GpuTimer &&other) noexcept { Swap(other); return *this; }
+
+	// Scopes can't nest: one `GL_TIME_ELAPSED` query may be active at a time
+	void Begin()
+	{
+		Collect();
+		if (m_pending == s_latency) m_pending--; // still not ready: drop the oldest result, its query gets reused
+		GLCall(glBeginQuery(GL_TIME_ELAPSED, m_queries[m_next]));
+	}
+	void End()
+	{
+		GLCall(glEndQuery(GL_TIME_ELAPSED));
+		m_next = (m_next + 1) % s_latency;
+		m_pending++;
+	}
+
+	float GetMilliseconds() const { return m_milliseconds; }
+
+private:
+	// Reads finished queries oldest first, stops at the first one still in flight
+	void Collect()
+	{
+		while (m_pending > 0)
+		{
+			const unsigned int query = m_queries[(m_next - m_pending + s_latency) % s_latency];
+			GLint available = 0;
+			GLCall(glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available));
+			if (!available) break;
+
+			GLuint64 nanoseconds = 0;
+			GLCall(glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds));
+			const float milliseconds = float(double(nanoseconds) * 1e-6);
+			m_milliseconds = Smooth(m_milliseconds, milliseconds);
+			m_pending--;
+		}
+	}
+
+	void Swap(GpuTimer &other)
+	{
+		std::swap(m_queries, other.m_queries);
+		std::swap(m_next, other.m_next);
+		std::swap(m_pending, other.m_pending);
+		std::swap(m_milliseconds, other.m_milliseconds);
+	}
+};
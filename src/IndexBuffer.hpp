@@ -1,28 +1,179 @@
 #pragma once
 
 #include "Utility.hpp"
+#include "GpuMemory.hpp"
 
 #include <GL/glew.h>
 
+#include <limits>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+
+// `GL_UNSIGNED_BYTE`/`GL_UNSIGNED_SHORT`/`GL_UNSIGNED_INT` for `unsigned char`/`short`/`int` index types
+template<class T> constexpr GLenum GetIndexType()
+{
+	static_assert(std::is_same_v<T, GLubyte> || std::is_same_v<T, GLushort> || std::is_same_v<T, GLuint>, "unsupported index type");
+	if constexpr (std::is_same_v<T, GLubyte>) return GL_UNSIGNED_BYTE;
+	else if constexpr (std::is_same_v<T, GLushort>) return GL_UNSIGNED_SHORT;
+	else return GL_UNSIGNED_INT;
+}
+
 class IndexBuffer
 {
-	unsigned int m_rendererId;
-	unsigned int m_count;
+	unsigned int m_rendererId = 0;
+	unsigned int m_count = 0;
+	unsigned int m_capacity = 0; // bytes
+	GLenum m_type = GL_UNSIGNED_INT;
+	GLenum m_usage = GL_STATIC_DRAW;
 
 public:
-	IndexBuffer(const unsigned int *data, unsigned int count) : m_count(count)
+	IndexBuffer() {} // empty, move-assign a real one later
+	IndexBuffer(const GLuint *data, unsigned int count, GLenum usage = GL_STATIC_DRAW) { Create(data, count, usage); }
+	IndexBuffer(const GLushort *data, unsigned int count, GLenum usage = GL_STATIC_DRAW) { Create(data, count, usage); }
+	IndexBuffer(const GLubyte *data, unsigned int count, GLenum usage = GL_STATIC_DRAW) { Create(data, count, usage); }
+	~IndexBuffer()
+	{
+		GpuMemory::Get().Free(GpuMemory::Object::buffer, m_rendererId);
+		GLCall(glDeleteBuffers(1, &m_rendererId)); // deleting `0` is a silent no-op
+	}
+
+	// Move-only: the GL name is owned by exactly one object
+	IndexBuffer(const IndexBuffer &) = delete;
+	IndexBuffer &operator=(const IndexBuffer &) = delete;
+	IndexBuffer(IndexBuffer &&other) noexcept
+		: m_rendererId(std::exchange(other.m_rendererId, 0)), m_count(std::exchange(other.m_count, 0)), m_capacity(std::exchange(other.m_capacity, 0)),
+		  m_type(other.m_type), m_usage(other.m_usage) {}
+	IndexBuffer &operator=(IndexBuffer &&other) noexcept
+	{
+		std::swap(m_rendererId, other.m_rendererId);
+		std::swap(m_count, other.m_count);
+		std::swap(m_capacity, other.m_capacity);
+		std::swap(m_type, other.m_type);
+		std::swap(m_usage, other.m_usage);
+		return *this;
+	}
+
+	// Static indices stored as 16-bit when `vertexCount` fits (half the bandwidth of 32-bit), 32-bit otherwise
+	static IndexBuffer CreateCompact(const GLuint *data, unsigned int count, unsigned int vertexCount, GLenum usage = GL_STATIC_DRAW)
 	{
-		static_assert(sizeof(m_count) == sizeof(GLuint));
+		CheckRange(data, count, vertexCount);
+		if (!FitsShort(vertexCount)) return IndexBuffer(data, count, usage);
 
-		GLCall(glGenBuffers(1, &m_rendererId));
-		GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_rendererId));
-		GLCall(glBufferData(GL_ARRAY_BUFFER, count * sizeof(float), data, GL_STATIC_DRAW));
+		const std::vector<GLushort> narrow = Narrow(data, count);
+		return IndexBuffer(narrow.data(), count, usage);
 	}
 
-	~IndexBuffer() { GLCall(glDeleteBuffers(1, &m_rendererId)); }
+	// `0 1 2 2 3 0` per quad for `quadCount` quads of 4 consecutive vertices: shared by every quad batch, draw a prefix of it
+	static IndexBuffer CreateQuads(unsigned int quadCount, GLenum usage = GL_STATIC_DRAW)
+	{
+		std::vector<GLuint> indices(std::size_t(quadCount) * 6);
+		for (std::size_t quad = 0; quad < quadCount; quad++)
+		{
+			const GLuint first = GLuint(quad * 4);
+			const GLuint pattern[] = { first, first + 1, first + 2, first + 2, first + 3, first };
+			std::copy(std::begin(pattern), std::end(pattern), indices.begin() + std::ptrdiff_t(quad * 6));
+		}
+		return CreateCompact(indices.data(), unsigned(indices.size()), quadCount * 4, usage);
+	}
+
+	// Empty buffer for per-frame index streams, see `SetData()`/`SetCompact()`
+	static IndexBuffer CreateDynamic(unsigned int capacity, GLenum type = GL_UNSIGNED_SHORT, GLenum usage = GL_DYNAMIC_DRAW)
+	{
+		IndexBuffer buffer;
+		buffer.m_type = type;
+		buffer.m_usage = usage;
+		buffer.m_capacity = capacity * GetSizeOfIndexType(type);
+		buffer.Allocate(nullptr);
+		return buffer;
+	}
+
+	// Replace contents (the index type may change): orphans the old storage so the GPU can keep reading it, grows when needed
+	template<class T>
+	void SetData(const T *data, unsigned int count)
+	{
+		const unsigned int size = unsigned(count * sizeof(T));
+		if (size > m_capacity)
+		{
+			m_capacity = size;
+			Allocate(data);
+		}
+		else
+		{
+			Allocate(nullptr); // orphan
+			if (HasDSA()) { GLCall(glNamedBufferSubData(m_rendererId, 0, size, data)); }
+			else /*    */ { GLCall(glBufferSubData(GL_COPY_WRITE_BUFFER, 0, size, data)); }
+		}
+		m_type = GetIndexType<T>();
+		m_count = count;
+	}
+
+	// `SetData()` narrowed to 16-bit when `vertexCount` fits
+	void SetCompact(const GLuint *data, unsigned int count, unsigned int vertexCount)
+	{
+		CheckRange(data, count, vertexCount);
+		if (!FitsShort(vertexCount)) return SetData(data, count);
+
+		const std::vector<GLushort> narrow = Narrow(data, count);
+		SetData(narrow.data(), count);
+	}
 
 	void Bind() const { GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_rendererId)); }
 	void Unbind() const { GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0)); }
 
 	unsigned int GetCount() const { return m_count; }
+	GLenum GetType() const { return m_type; }
+	unsigned int GetTypeSize() const { return GetSizeOfIndexType(m_type); }
+
+	static unsigned int GetSizeOfIndexType(GLenum type) { return type == GL_UNSIGNED_BYTE ? 1u : type == GL_UNSIGNED_SHORT ? 2u : 4u; }
+
+private:
+	// Uploads go through `GL_COPY_WRITE_BUFFER`: binding `GL_ELEMENT_ARRAY_BUFFER` would silently rewire whatever VAO is bound
+	template<class T>
+	void Create(const T *data, unsigned int count, GLenum usage)
+	{
+		m_count = count;
+		m_capacity = unsigned(count * sizeof(T));
+		m_type = GetIndexType<T>();
+		m_usage = usage;
+		Allocate(data);
+	}
+
+	// (Re)specify `m_capacity` bytes of mutable storage - index buffers may be refilled, so no immutable `glNamedBufferStorage` here
+	// the bind path leaves the buffer bound to `GL_COPY_WRITE_BUFFER` for a following `glBufferSubData`
+	void Allocate(const void *data)
+	{
+		if (HasDSA())
+		{
+			if (!m_rendererId) { GLCall(glCreateBuffers(1, &m_rendererId)); }
+			GLCall(glNamedBufferData(m_rendererId, m_capacity, data, m_usage));
+		}
+		else
+		{
+			if (!m_rendererId) { GLCall(glGenBuffers(1, &m_rendererId)); }
+			GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_rendererId));
+			GLCall(glBufferData(GL_COPY_WRITE_BUFFER, m_capacity, data, m_usage));
+		}
+		GpuMemory::Get().Allocate(GpuMemory::Object::buffer, m_rendererId, GpuMemory::Category::index, m_capacity);
+	}
+
+	static bool FitsShort(unsigned int vertexCount) { return vertexCount <= std::numeric_limits<GLushort>::max() + 1u; }
+
+	// Debug builds: the index type is picked from `vertexCount`, too small a count would silently truncate indices
+	static void CheckRange([[maybe_unused]] const GLuint *data, [[maybe_unused]] unsigned int count, [[maybe_unused]] unsigned int vertexCount)
+	{
+#ifndef NDEBUG
+		if (count) ASSERT(*std::max_element(data, data + count) < vertexCount);
+#endif
+	}
+
+	static std::vector<GLushort> Narrow(const GLuint *data, unsigned int count)
+	{
+		std::vector<GLushort> narrow(count);
+		for (unsigned int i = 0; i < count; i++)
+			narrow[i] = GLushort(data[i]);
+		return narrow;
+	}
 };
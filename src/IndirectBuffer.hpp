@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Utility.hpp"
+#include "GpuMemory.hpp"
+
+#include <GL/glew.h>
+
+#include <vector>
+#include <utility>
+
+// Layout mandated by `glMultiDrawElementsIndirect` (GL 4.3 / ARB_multi_draw_indirect)
+struct DrawElementsIndirectCommand
+{
+	GLuint count;         // indices
+	GLuint instanceCount;
+	GLuint firstIndex;    // in indices, not bytes
+	GLint  baseVertex;
+	GLuint baseInstance;  // GL 4.2+: offsets instanced attributes - usable as a per-draw id
+};
+
+static_assert(sizeof(DrawElementsIndirectCommand) == 5 * 4);
+
+// CPU-side list of sub-draws mirrored into a `GL_DRAW_INDIRECT_BUFFER` (see `Renderer::DrawIndirect()`)
+class IndirectBuffer
+{
+	unsigned int m_rendererId = 0;
+	size_t m_capacity = 0; // commands allocated on the GPU
+	bool m_dirty = false;  // CPU list changed since the last `Upload()`
+	std::vector<DrawElementsIndirectCommand> m_commands;
+
+public:
+	IndirectBuffer() {}
+	~IndirectBuffer()
+	{
+		GpuMemory::Get().Free(GpuMemory::Object::buffer, m_rendererId);
+		GLCall(glDeleteBuffers(1, &m_rendererId)); // deleting `0` is a silent no-op
+	}
+
+	// Move-only: the GL name is owned by exactly one object
+	IndirectBuffer(const IndirectBuffer &) = delete;
+	IndirectBuffer &operator=(const IndirectBuffer &) = delete;
+	IndirectBuffer(IndirectBuffer &&other) noexcept
+		: m_rendererId(std::exchange(other.m_rendererId, 0)), m_capacity(std::exchange(other.m_capacity, 0)), m_dirty(std::exchange(other.m_dirty, false)),
+		  m_commands(std::move(other.m_commands)) {}
+	IndirectBuffer &operator=(IndirectBuffer &&other) noexcept
+	{
+		std::swap(m_rendererId, other.m_rendererId);
+		std::swap(m_capacity, other.m_capacity);
+		std::swap(m_dirty, other.m_dirty);
+		std::swap(m_commands, other.m_commands);
+		return *this;
+	}
+
+	static bool IsSupported() { return GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect; }
+
+	void Clear() { m_commands.clear(); m_dirty = true; }
+	void Add(GLuint count, GLuint firstIndex, GLint baseVertex, GLuint instanceCount = 1, GLuint baseInstance = 0)
+	{
+		m_commands.push_back({ count, instanceCount, firstIndex, baseVertex, baseInstance });
+		m_dirty = true;
+	}
+
+	// Mirror the command list to the GPU (orphaning the previous storage), only needed on the indirect path
+	// a no-op (bind only) when the list is unchanged - commands the GPU wrote itself (e.g. culling counts) survive
+	void Upload()
+	{
+		if (!m_dirty) { Bind(); return; }
+		m_dirty = false;
+
+		const size_t size = m_commands.size() * sizeof(DrawElementsIndirectCommand);
+		if (HasDSA())
+		{
+			if (!m_rendererId) { GLCall(glCreateBuffers(1, &m_rendererId)); }
+			if (m_commands.size() > m_capacity)
+			{
+				m_capacity = m_commands.size();
+				GLCall(glNamedBufferData(m_rendererId, size, m_commands.data(), GL_STREAM_DRAW));
+				GpuMemory::Get().Allocate(GpuMemory::Object::buffer, m_rendererId, GpuMemory::Category::indirect, size);
+			}
+			else
+			{
+				// orphan: invalidate without respecifying (GL 4.3), or respecify - DSA may come from the ARB extension on older contexts
+				if (GLEW_VERSION_4_3 || GLEW_ARB_invalidate_subdata) { GLCall(glInvalidateBufferData(m_rendererId)); }
+				else { GLCall(glNamedBufferData(m_rendererId, m_capacity * sizeof(DrawElementsIndirectCommand), nullptr, GL_STREAM_DRAW)); }
+				GLCall(glNamedBufferSubData(m_rendererId, 0, size, m_commands.data()));
+			}
+			Bind(); // the draw still sources `GL_DRAW_INDIRECT_BUFFER`
+			return;
+		}
+
+		if (!m_rendererId) { GLCall(glGenBuffers(1, &m_rendererId)); }
+		GLCall(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_rendererId));
+		if (m_commands.size() > m_capacity)
+		{
+			m_capacity = m_commands.size();
+			GLCall(glBufferData(GL_DRAW_INDIRECT_BUFFER, size, m_commands.data(), GL_STREAM_DRAW));
+			GpuMemory::Get().Allocate(GpuMemory::Object::buffer, m_rendererId, GpuMemory::Category::indirect, size);
+		}
+		else
+		{
+			GLCall(glBufferData(GL_DRAW_INDIRECT_BUFFER, m_capacity * sizeof(DrawElementsIndirectCommand), nullptr, GL_STREAM_DRAW));
+			GLCall(glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, size, m_commands.data()));
+		}
+	}
+
+	void Bind() const { GLCall(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_rendererId)); }
+	void Unbind() const { GLCall(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0)); }
+
+	unsigned int GetRendererId() const { return m_rendererId; }
+	const std::vector<DrawElementsIndirectCommand> &GetCommands() const { return m_commands; }
+	size_t GetCount() const { return m_commands.size(); }
+};
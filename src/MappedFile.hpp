@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <filesystem>
+
+#if defined(_WIN32)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#endif
+
+// Read-only memory-mapped file (move-only). Pages are faulted in on first touch, so `glTexImage2D` & co. read straight from the page cache
+class MappedFile
+{
+	const unsigned char *m_data = nullptr;
+	std::size_t m_size = 0;
+
+public:
+	MappedFile() {}
+	explicit MappedFile(const std::filesystem::path &path)
+	{
+#if defined(_WIN32)
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) return;
+
+		LARGE_INTEGER size;
+		if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+		{
+			if (HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr))
+			{
+				m_data = static_cast<const unsigned char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+				m_size = m_data ? std::size_t(size.QuadPart) : 0;
+				CloseHandle(mapping); // the view keeps the mapping alive
+			}
+		}
+		CloseHandle(file);
+#else
+		const int fd = open(path.c_str(), O_RDONLY);
+		if (fd == -1) return;
+
+		struct stat info;
+		if (fstat(fd, &info) == 0 && info.st_size > 0)
+		{
+			void *data = mmap(nullptr, std::size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			if (data != MAP_FAILED)
+			{
+				m_data = static_cast<const unsigned char *>(data);
+				m_size = std::size_t(info.st_size);
+			}
+		}
+		close(fd); // the mapping keeps the file alive
+#endif
+	}
+	~MappedFile() { Unmap(); }
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+	MappedFile(MappedFile &&other) noexcept : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) {}
+	MappedFile &operator=(MappedFile &&other) noexcept
+	{
+		if (this != &other)
+		{
+			Unmap();
+			m_data = std::exchange(other.m_data, nullptr);
+			m_size = std::exchange(other.m_size, 0);
+		}
+		return *this;
+	}
+
+	bool IsOpen() const { return m_data != nullptr; }
+	const unsigned char *GetData() const { return m_data; }
+	std::size_t GetSize() const { return m_size; }
+
+private:
+	void Unmap()
+	{
+		if (!m_data) return;
+#if defined(_WIN32)
+		UnmapViewOfFile(m_data);
+#else
+		munmap(const_cast<unsigned char *>(m_data), m_size);
+#endif
+		m_data = nullptr;
+		m_size = 0;
+	}
+};
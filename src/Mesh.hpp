@@ -0,0 +1,369 @@
+#pragma once
+
+#include "Utility.hpp"
+#include "VertexArray.hpp"
+#include "VertexBuffer.hpp"
+#include "VertexBufferLayout.hpp"
+#include "IndexBuffer.hpp"
+#include "MeshFile.hpp"
+#include "Resources.hpp"
+
+#include <GL/glew.h>
+
+#include <array>
+#include <cmath>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+
+// Mesh vertex, matches the attributes of `Mesh.shader`
+struct MeshVertex {
+	std::array<float, 3> position{ 0.0f, 0.0f, 0.0f };
+	std::array<float, 3> normal{ 0.0f, 0.0f, 0.0f };
+	std::array<float, 2> texcoord{ 0.0f, 0.0f };
+
+	static VertexBufferLayout GetLayout()
+	{
+		VertexBufferLayout layout;
+		layout.Push<float>(3); // coord xyz
+		layout.Push<float>(3); // normal xyz
+		layout.Push<float>(2); // texcoord xy
+		return layout;
+	}
+};
+
+static_assert(sizeof(MeshVertex) == 8 * sizeof(float));
+
+// Indexed triangle mesh imported from Wavefront `.obj`:
+// - face corners (`v/vt/vn` triples) are deduplicated through a hash map: each unique corner is one vertex
+// - triangles are reordered for the post-transform vertex cache (Forsyth's linear-speed optimizer)
+// - the result is saved as `<name>.cmesh` next to the source; later loads map it and upload straight from the mapping
+class Mesh
+{
+public:
+	static constexpr unsigned int s_simulatedCacheSize = 16; // FIFO entries of the ACMR estimate (conservative hardware)
+
+	struct Stats
+	{
+		bool fromCache = false;
+		float loadMilliseconds = 0.0f;
+		std::uint32_t corners = 0, vertices = 0, triangles = 0;
+		float acmrSource = 0.0f, acmrOptimized = 0.0f;
+	};
+
+private:
+	VertexBuffer m_vertexBuffer;
+	VertexArray  m_vao;
+	IndexBuffer  m_indexBuffer;
+	Stats m_stats;
+
+public:
+	Mesh() {} // empty, move-assign a real one later
+	// Prefers an up-to-date `<name>.cmesh` next to `path`, imports `path` (and writes the cache) otherwise
+	explicit Mesh(const std::filesystem::path &path)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		const std::filesystem::path cache = std::filesystem::path(path).replace_extension(".cmesh");
+		if (!IsStale(cache, path) && LoadCache(cache)) m_stats.fromCache = true;
+		else Import(path, cache);
+		m_stats.loadMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	const VertexArray &GetVertexArray() const { return m_vao; }
+	const IndexBuffer &GetIndexBuffer() const { return m_indexBuffer; }
+	const Stats &GetStats() const { return m_stats; }
+	bool IsLoaded() const { return m_stats.triangles != 0; }
+
+	// Average cache miss ratio: vertex shader runs per triangle through a `cacheSize` FIFO (3.0 - no reuse, ~0.5 - ideal grid)
+	static float GetAcmr(const std::vector<std::uint32_t> &indices, std::uint32_t vertexCount, unsigned int cacheSize = s_simulatedCacheSize)
+	{
+		if (indices.size() < 3) return 0.0f;
+		std::vector<std::uint32_t> insertedAt(vertexCount, 0); // FIFO stamp + 1, 0 - never inserted
+		std::uint32_t misses = 0;
+		for (const std::uint32_t index : indices)
+			if (!insertedAt[index] || misses + 1 - insertedAt[index] > cacheSize) insertedAt[index] = ++misses;
+		return float(misses) / float(indices.size() / 3);
+	}
+
+	// Reorders triangles (never vertices) so consecutive triangles reuse recently shaded vertices
+	// Tom Forsyth, "Linear-Speed Vertex Cache Optimisation": greedy, scores from LRU position and remaining valence
+	static void OptimizeVertexCache(std::vector<std::uint32_t> &indices, std::uint32_t vertexCount)
+	{
+		constexpr int cacheSize = 32;
+		const std::uint32_t triangleCount = std::uint32_t(indices.size() / 3);
+		if (triangleCount == 0) return;
+
+		// vertex -> triangles adjacency (CSR)
+		std::vector<std::uint32_t> offsets(vertexCount + 1, 0), remaining(vertexCount, 0), adjacency(indices.size());
+		for (const std::uint32_t index : indices) remaining[index]++;
+		for (std::uint32_t v = 0; v < vertexCount; v++) offsets[v + 1] = offsets[v] + remaining[v];
+		std::vector<std::uint32_t> fill(offsets.begin(), offsets.end() - 1);
+		for (std::uint32_t t = 0; t < triangleCount; t++)
+			for (int corner = 0; corner < 3; corner++) adjacency[fill[indices[t * 3 + corner]]++] = t;
+
+		std::vector<int> cachePosition(vertexCount, -1);
+		std::vector<float> vertexScore(vertexCount), triangleScore(triangleCount, 0.0f);
+		std::vector<char> emitted(triangleCount, 0);
+		const auto score = [&](std::uint32_t v) {
+			if (remaining[v] == 0) return -1.0f;
+			float value = 0.0f;
+			if (const int position = cachePosition[v]; position >= 0)
+				value = position < 3 ? 0.75f : std::pow(1.0f - float(position - 3) / float(cacheSize - 3), 1.5f);
+			return value + 2.0f / std::sqrt(float(remaining[v])); // valence boost: finish off lonely vertices
+		};
+		for (std::uint32_t v = 0; v < vertexCount; v++) vertexScore[v] = score(v);
+		for (std::uint32_t t = 0; t < triangleCount; t++)
+			for (int corner = 0; corner < 3; corner++) triangleScore[t] += vertexScore[indices[t * 3 + corner]];
+
+		std::vector<std::uint32_t> output;
+		output.reserve(indices.size());
+		std::vector<std::uint32_t> cache, nextCache; // LRU, most recent first
+		std::uint32_t scanCursor = 0; // linear fallback when no cached vertex has triangles left
+		std::uint32_t best = 0;
+		float bestScore = -1.0f;
+		for (std::uint32_t t = 0; t < triangleCount; t++)
+			if (triangleScore[t] > bestScore) { bestScore = triangleScore[t]; best = t; }
+
+		for (std::uint32_t emittedCount = 0; emittedCount < triangleCount; emittedCount++)
+		{
+			if (bestScore < 0.0f) // pick the next untouched triangle in order
+			{
+				while (emitted[scanCursor]) scanCursor++;
+				best = scanCursor;
+			}
+			emitted[best] = 1;
+			const std::uint32_t *corners = &indices[best * 3];
+			output.insert(output.end(), corners, corners + 3);
+
+			// remove `best` from its vertices' adjacency, move them to the cache front
+			nextCache.assign(corners, corners + 3);
+			for (int corner = 0; corner < 3; corner++)
+			{
+				const std::uint32_t v = corners[corner];
+				std::uint32_t *begin = &adjacency[offsets[v]], *end = begin + remaining[v];
+				std::iter_swap(std::find(begin, end, best), end - 1);
+				remaining[v]--;
+			}
+			for (const std::uint32_t v : cache)
+				if (v != corners[0] && v != corners[1] && v != corners[2]) nextCache.push_back(v);
+			for (std::size_t i = 0; i < nextCache.size(); i++) cachePosition[nextCache[i]] = i < std::size_t(cacheSize) ? int(i) : -1;
+
+			// rescore the touched vertices (including the ones that fell out) and their triangles
+			for (const std::uint32_t v : nextCache)
+			{
+				const float delta = score(v) - vertexScore[v];
+				vertexScore[v] += delta;
+				for (std::uint32_t i = offsets[v]; i < offsets[v] + remaining[v]; i++)
+					triangleScore[adjacency[i]] += delta;
+			}
+			nextCache.resize(std::min(nextCache.size(), std::size_t(cacheSize)));
+			std::swap(cache, nextCache);
+
+			// best candidate: a triangle of a cached vertex, the linear scan otherwise
+			bestScore = -1.0f;
+			for (const std::uint32_t v : cache)
+				for (std::uint32_t i = offsets[v]; i < offsets[v] + remaining[v]; i++)
+					if (triangleScore[adjacency[i]] > bestScore) { bestScore = triangleScore[adjacency[i]]; best = adjacency[i]; }
+		}
+		indices.swap(output);
+	}
+
+private:
+	// Loose source newer than the loose cache (a packed cache is trusted)
+	static bool IsStale(const std::filesystem::path &cache, const std::filesystem::path &source)
+	{
+		std::error_code error;
+		const auto cacheTime = std::filesystem::last_write_time(cache, error);
+		if (error) return false;
+		const auto sourceTime = std::filesystem::last_write_time(source, error);
+		return !error && sourceTime > cacheTime;
+	}
+
+	// Fast path: the mapped arrays go to the GPU as is (no parse, no intermediate copy)
+	bool LoadCache(const std::filesystem::path &path)
+	{
+		const Resource file = Resources::Get().Load(path);
+		if (!file) return false;
+
+		const cmesh::Header *header = cmesh::Validate(file.GetData(), file.GetSize(), sizeof(MeshVertex));
+		if (!header)
+		{ std::cerr << "Warning: invalid mesh cache: " << path << std::endl; return false; }
+
+		const unsigned char *indices = file.GetData() + header->indexOffset;
+		Upload(file.GetData() + header->vertexOffset, header->vertexCount,
+			header->indexSize == 2 ? IndexBuffer(reinterpret_cast<const GLushort *>(indices), header->indexCount)
+			/*                  */ : IndexBuffer(reinterpret_cast<const GLuint *>(indices), header->indexCount));
+
+		m_stats.corners = header->sourceCorners;
+		m_stats.vertices = header->vertexCount;
+		m_stats.triangles = header->indexCount / 3;
+		m_stats.acmrSource = header->acmrSource;
+		m_stats.acmrOptimized = header->acmrOptimized;
+		return true;
+	}
+
+	void Import(const std::filesystem::path &path, const std::filesystem::path &cache)
+	{
+		const Resource file = Resources::Get().Load(path);
+		if (!file)
+		{ std::cerr << "Error: Mesh: can't open " << path << std::endl; return; }
+
+		std::vector<MeshVertex> vertices;
+		std::vector<std::uint32_t> indices;
+		if (!ParseObj(std::string(file.GetText()), vertices, indices))
+		{ std::cerr << "Error: Mesh: no triangles in " << path << std::endl; return; }
+
+		m_stats.corners = std::uint32_t(indices.size());
+		m_stats.vertices = std::uint32_t(vertices.size());
+		m_stats.triangles = std::uint32_t(indices.size() / 3);
+		m_stats.acmrSource = GetAcmr(indices, m_stats.vertices);
+		OptimizeVertexCache(indices, m_stats.vertices);
+		m_stats.acmrOptimized = GetAcmr(indices, m_stats.vertices);
+
+		Upload(vertices.data(), m_stats.vertices, IndexBuffer::CreateCompact(indices.data(), unsigned(indices.size()), m_stats.vertices));
+		WriteCache(cache, vertices, indices);
+		std::cout << "Info: Mesh: imported " << path << " - " << m_stats.triangles << " triangles, " << m_stats.vertices << " vertices (from "
+			<< m_stats.corners << " corners), ACMR " << m_stats.acmrSource << " -> " << m_stats.acmrOptimized << std::endl;
+	}
+
+	void Upload(const void *vertices, std::uint32_t vertexCount, IndexBuffer &&indexBuffer)
+	{
+		m_vertexBuffer = VertexBuffer(vertices, unsigned(vertexCount * sizeof(MeshVertex)));
+		m_vao = VertexArray::Create();
+		m_vao.AddBuffer(m_vertexBuffer, MeshVertex::GetLayout());
+		m_indexBuffer = std::move(indexBuffer);
+	}
+
+	void WriteCache(const std::filesystem::path &path, const std::vector<MeshVertex> &vertices, const std::vector<std::uint32_t> &indices) const
+	{
+		cmesh::Header header = {};
+		std::copy(std::begin(cmesh::magic), std::end(cmesh::magic), header.magic);
+		header.version = cmesh::version;
+		header.vertexCount = std::uint32_t(vertices.size());
+		header.vertexStride = sizeof(MeshVertex);
+		header.indexCount = std::uint32_t(indices.size());
+		header.indexSize = vertices.size() <= 0x10000 ? 2 : 4; // same width as `IndexBuffer::CreateCompact()` picks
+		header.sourceCorners = m_stats.corners;
+		header.acmrSource = m_stats.acmrSource;
+		header.acmrOptimized = m_stats.acmrOptimized;
+		header.vertexOffset = cmesh::Align(sizeof(header));
+		header.indexOffset = cmesh::Align(header.vertexOffset + vertices.size() * sizeof(MeshVertex));
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file)
+		{ std::cerr << "Warning: Mesh: can't write cache " << path << std::endl; return; }
+
+		const auto pad = [&file](std::uint64_t offset) { while (std::uint64_t(file.tellp()) < offset) file.put('\0'); };
+		file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		pad(header.vertexOffset);
+		file.write(reinterpret_cast<const char *>(vertices.data()), std::streamsize(vertices.size() * sizeof(MeshVertex)));
+		pad(header.indexOffset);
+		if (header.indexSize == 2)
+		{
+			const std::vector<std::uint16_t> narrow(indices.begin(), indices.end());
+			file.write(reinterpret_cast<const char *>(narrow.data()), std::streamsize(narrow.size() * sizeof(std::uint16_t)));
+		}
+		else
+			file.write(reinterpret_cast<const char *>(indices.data()), std::streamsize(indices.size() * sizeof(std::uint32_t)));
+	}
+
+	// `v`, `vt`, `vn`, `f` (`v`, `v/vt`, `v//vn`, `v/vt/vn`, negative = relative); polygons are fanned into triangles
+	// smooth normals are generated when the file has none
+	static bool ParseObj(const std::string &text, std::vector<MeshVertex> &vertices, std::vector<std::uint32_t> &indices)
+	{
+		struct Corner
+		{
+			int v, vt, vn;
+			bool operator==(const Corner &other) const { return v == other.v && vt == other.vt && vn == other.vn; }
+		};
+		struct CornerHash
+		{
+			std::size_t operator()(const Corner &corner) const
+			{
+				std::uint64_t h = std::uint64_t(std::uint32_t(corner.v)) * 0x9E3779B97F4A7C15ull;
+				h ^= (std::uint64_t(std::uint32_t(corner.vt)) + 0x7F4A7C15ull + (h << 6) + (h >> 2));
+				h ^= (std::uint64_t(std::uint32_t(corner.vn)) * 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2));
+				return std::size_t(h ^ (h >> 32));
+			}
+		};
+
+		std::vector<std::array<float, 3>> positions, normals;
+		std::vector<std::array<float, 2>> texcoords;
+		std::unordered_map<Corner, std::uint32_t, CornerHash> unique;
+		std::vector<std::uint32_t> polygon;
+
+		const char *cursor = text.c_str();
+		const auto skipSpaces = [&cursor] { while (*cursor == ' ' || *cursor == '\t') cursor++; };
+		const auto readFloat = [&cursor] { char *end; const float value = std::strtof(cursor, &end); cursor = end; return value; };
+		const auto resolve = [](long index, std::size_t count) { return int(index < 0 ? long(count) + index : index - 1); };
+
+		while (*cursor)
+		{
+			skipSpaces();
+			if (cursor[0] == 'v' && cursor[1] == ' ')
+			{ cursor += 2; positions.push_back({ readFloat(), readFloat(), readFloat() }); }
+			else if (cursor[0] == 'v' && cursor[1] == 't' && cursor[2] == ' ')
+			{ cursor += 3; texcoords.push_back({ readFloat(), readFloat() }); }
+			else if (cursor[0] == 'v' && cursor[1] == 'n' && cursor[2] == ' ')
+			{ cursor += 3; normals.push_back({ readFloat(), readFloat(), readFloat() }); }
+			else if (cursor[0] == 'f' && cursor[1] == ' ')
+			{
+				cursor += 2;
+				polygon.clear();
+				for (skipSpaces(); *cursor && *cursor != '\n' && *cursor != '\r'; skipSpaces())
+				{
+					char *end;
+					Corner corner = { resolve(std::strtol(cursor, &end, 10), positions.size()), -1, -1 };
+					if (end == cursor) break; // malformed
+					cursor = end;
+					if (*cursor == '/')
+					{
+						if (*++cursor != '/') { corner.vt = resolve(std::strtol(cursor, &end, 10), texcoords.size()); cursor = end; }
+						if (*cursor == '/') { corner.vn = resolve(std::strtol(cursor + 1, &end, 10), normals.size()); cursor = end; }
+					}
+					if (corner.v < 0 || std::size_t(corner.v) >= positions.size()) continue;
+					if (corner.vt >= int(texcoords.size())) corner.vt = -1;
+					if (corner.vn >= int(normals.size())) corner.vn = -1;
+
+					const auto [it, inserted] = unique.try_emplace(corner, std::uint32_t(vertices.size()));
+					if (inserted)
+					{
+						MeshVertex vertex;
+						vertex.position = positions[std::size_t(corner.v)];
+						if (corner.vn >= 0) vertex.normal = normals[std::size_t(corner.vn)];
+						if (corner.vt >= 0) vertex.texcoord = texcoords[std::size_t(corner.vt)];
+						vertices.push_back(vertex);
+					}
+					polygon.push_back(it->second);
+				}
+				for (std::size_t i = 2; i < polygon.size(); i++)
+					indices.insert(indices.end(), { polygon[0], polygon[i - 1], polygon[i] });
+			}
+			while (*cursor && *cursor != '\n') cursor++; // rest of the line (comments, `o`, `g`, `s`, `usemtl` ...)
+			if (*cursor) cursor++;
+		}
+
+		if (normals.empty()) // area-weighted face normals, summed per vertex
+			for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+			{
+				const auto &a = vertices[indices[i]].position, &b = vertices[indices[i + 1]].position, &c = vertices[indices[i + 2]].position;
+				const float e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] }, e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+				const float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+				for (int corner = 0; corner < 3; corner++)
+					for (int axis = 0; axis < 3; axis++) vertices[indices[i + corner]].normal[axis] += n[axis];
+			}
+		for (MeshVertex &vertex : vertices)
+		{
+			const float length = std::sqrt(vertex.normal[0] * vertex.normal[0] + vertex.normal[1] * vertex.normal[1] + vertex.normal[2] * vertex.normal[2]);
+			if (length > 0.0f) for (float &axis : vertex.normal) axis /= length;
+		}
+		return !indices.empty();
+	}
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+// `.cmesh` - imported mesh cache written by `Mesh` next to its source (`<name>.obj` -> `<name>.cmesh`)
+// layout: [Header][vertices][indices], little-endian, both arrays 16-byte aligned: mapped, they are uploaded as is
+// vertices are deduplicated, indices already reordered for the post-transform vertex cache
+namespace cmesh
+{
+
+constexpr char          magic[4] = { 'C', 'M', 'S', 'H' };
+constexpr std::uint32_t version  = 1;
+constexpr std::size_t   alignment = 16;
+
+struct Header
+{
+	char          magic[4];
+	std::uint32_t version;
+	std::uint32_t vertexCount;
+	std::uint32_t vertexStride; // bytes, must match the loader's vertex
+	std::uint32_t indexCount;
+	std::uint32_t indexSize;    // 2 or 4 bytes
+	std::uint32_t sourceCorners; // face corners in the source (vertex shader runs of a non-indexed draw)
+	float         acmrSource;   // simulated average cache miss ratio (vertices shaded per triangle), import order
+	float         acmrOptimized; // ... after reordering
+	std::uint32_t reserved;
+	std::uint64_t vertexOffset; // from the start of the file
+	std::uint64_t indexOffset;
+};
+
+static_assert(sizeof(Header) == 56);
+
+constexpr std::size_t Align(std::size_t offset) { return (offset + alignment - 1) / alignment * alignment; }
+
+template<class Index>
+inline bool IndicesInRange(const Index *indices, std::uint32_t count, std::uint32_t vertexCount)
+{
+	Index largest = 0;
+	for (std::uint32_t i = 0; i < count; i++) largest = indices[i] > largest ? indices[i] : largest;
+	return count == 0 || std::uint64_t(largest) < vertexCount;
+}
+
+// Returns `nullptr` if `data` is not a complete, well-formed cache for vertices of `vertexStride` bytes
+inline const Header *Validate(const void *data, std::size_t size, std::uint32_t vertexStride)
+{
+	if (!data || size < sizeof(Header)) return nullptr;
+
+	const auto *header = static_cast<const Header *>(data);
+	if (std::memcmp(header->magic, magic, sizeof(magic)) != 0 || header->version != version) return nullptr;
+	if (header->vertexStride != vertexStride || (header->indexSize != 2 && header->indexSize != 4)) return nullptr;
+	if (header->vertexOffset % alignment || header->indexOffset % alignment) return nullptr;
+
+	const std::uint64_t vertexBytes = std::uint64_t(header->vertexCount) * header->vertexStride;
+	const std::uint64_t indexBytes = std::uint64_t(header->indexCount) * header->indexSize;
+	if (header->vertexOffset > size || vertexBytes > size - header->vertexOffset) return nullptr;
+	if (header->indexOffset > size || indexBytes > size - header->indexOffset) return nullptr;
+
+	// uploaded as is: an out-of-range index would make the GPU fetch past the vertex buffer
+	if (header->indexCount % 3 != 0) return nullptr;
+	const unsigned char *indices = static_cast<const unsigned char *>(data) + header->indexOffset;
+	if (header->indexSize == 2)
+		return IndicesInRange(reinterpret_cast<const std::uint16_t *>(indices), header->indexCount, header->vertexCount) ? header : nullptr;
+	return IndicesInRange(reinterpret_cast<const std::uint32_t *>(indices), header->indexCount, header->vertexCount) ? header : nullptr;
+}
+
+}
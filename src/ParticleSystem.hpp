@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Utility.hpp"
+#include "VertexArray.hpp"
+#include "VertexBuffer.hpp"
+#include "VertexBufferLayout.hpp"
+#include "Shader.hpp"
+#include "Assets.hpp"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+// GPU-resident particles: emission, integration and lifetime run in a compute shader (GL 4.3) or a transform feedback
+// ping-pong (GL 3.3), rendering sources the same buffer - particle data never travels back to the CPU
+class ParticleSystem
+{
+public:
+	// Matches `struct Particle` (std430) in `Particles-Update.shader` and the `#feedback` order in `Particles-Feedback.shader`
+	struct Particle
+	{
+		float position[2];
+		float velocity[2];
+		float life;     // seconds left, <= 0 - dead (respawned by the next update)
+		float lifetime; // seconds at spawn
+		float seed;
+		float size;     // pixels
+	};
+	static_assert(sizeof(Particle) == 8 * 4);
+
+	static constexpr unsigned int s_groupSize = 256;                  // `local_size_x` of the compute shader
+	static constexpr unsigned int s_maxCount  = 65535u * s_groupSize; // `GL_MAX_COMPUTE_WORK_GROUP_COUNT` guaranteed minimum
+
+private:
+	VertexBuffer m_buffers[2]; // compute path: [0] only, transform feedback: source/destination swap every update
+	VertexArray  m_vaos[2];
+	int m_current = 0;
+	unsigned int m_count = 0;
+	bool m_compute = false;
+	bool m_reset = true;
+	float m_time = 0.0f;
+	glm::vec2 m_gravity = glm::vec2(0.0f, -200.0f);
+
+	AssetRef<Shader> m_update;
+	AssetRef<Shader> m_render;
+
+public:
+	static bool IsComputeSupported() { return GLEW_VERSION_4_3 || (GLEW_ARB_compute_shader && GLEW_ARB_shader_storage_buffer_object); }
+
+	ParticleSystem() {}
+	ParticleSystem(unsigned int count, bool compute = IsComputeSupported())
+		: m_count(std::min(count, s_maxCount)), m_compute(compute && IsComputeSupported())
+	{
+		VertexBufferLayout layout;
+		layout.Push<float>(2); // position xy
+		layout.Push<float>(2); // velocity xy
+		layout.Push<float>(1); // life
+		layout.Push<float>(1); // lifetime
+		layout.Push<float>(1); // seed
+		layout.Push<float>(1); // size
+
+		// no initial upload: contents are undefined until the first update respawns every particle (`u_Reset`)
+		for (int i = 0; i < (m_compute ? 1 : 2); i++)
+		{
+			m_buffers[i] = VertexBuffer(nullptr, unsigned(m_count * sizeof(Particle)), GL_DYNAMIC_COPY);
+			m_vaos[i] = VertexArray::Create();
+			m_vaos[i].AddBuffer(m_buffers[i], layout);
+		}
+
+		m_update = Assets::LoadShader(m_compute ? "res/Shaders/Particles-Update.shader" : "res/Shaders/Particles-Feedback.shader");
+		m_render = Assets::LoadShader("res/Shaders/Particles.shader");
+	}
+
+	// One simulation step for all particles, entirely on the GPU
+	void Update(float deltaTime, glm::vec2 emitter)
+	{
+		if (m_count == 0) return;
+		m_time += deltaTime;
+
+		Shader &shader = *m_update;
+		shader.Bind();
+		shader.SetUniform1f("u_DeltaTime", deltaTime);
+		shader.SetUniform1f("u_Time", m_time);
+		shader.SetUniform2f("u_Emitter", emitter.x, emitter.y);
+		shader.SetUniform2f("u_Gravity", m_gravity.x, m_gravity.y);
+		shader.SetUniform1i("u_Reset", m_reset);
+		m_reset = false;
+
+		if (m_compute)
+		{
+			shader.SetUniform1i("u_Count", int(m_count));
+			GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_buffers[0].GetRendererId()));
+			GLCall(glDispatchCompute((m_count + s_groupSize - 1) / s_groupSize, 1, 1));
+			GLCall(glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT)); // writes visible to draws and the next dispatch
+			GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0));
+			return;
+		}
+
+		// vertex shader only: read `m_current` as attributes, capture into the other buffer, rasterize nothing
+		const int next = 1 - m_current;
+		GLCall(glEnable(GL_RASTERIZER_DISCARD));
+		m_vaos[m_current].Bind();
+		GLCall(glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, m_buffers[next].GetRendererId()));
+		GLCall(glBeginTransformFeedback(GL_POINTS));
+		GLCall(glDrawArrays(GL_POINTS, 0, GLsizei(m_count)));
+		GLCall(glEndTransformFeedback());
+		GLCall(glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0));
+		GLCall(glDisable(GL_RASTERIZER_DISCARD));
+		m_current = next;
+	}
+
+	// Additive point sprites straight from the simulation buffer
+	void Render(glm::mat4 mvp) const
+	{
+		if (m_count == 0) return;
+
+		m_render->Bind();
+		m_render->SetUniformMat4f("u_MVP", mvp);
+		m_vaos[m_current].Bind();
+
+		GLCall(glEnable(GL_PROGRAM_POINT_SIZE));
+		GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE));
+		GLCall(glDrawArrays(GL_POINTS, 0, GLsizei(m_count)));
+		GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+		GLCall(glDisable(GL_PROGRAM_POINT_SIZE));
+	}
+
+	void SetGravity(glm::vec2 gravity) { m_gravity = gravity; }
+	glm::vec2 GetGravity() const { return m_gravity; }
+
+	unsigned int GetCount() const { return m_count; }
+	bool IsCompute() const { return m_compute; }
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Utility.hpp"
+#include "VertexArray.hpp"
+#include "VertexBuffer.hpp"
+#include "VertexBufferLayout.hpp"
+#include "IndexBuffer.hpp"
+
+#include <GL/glew.h>
+
+#include <utility>
+#include <algorithm>
+
+// Streamed GPU storage for a batch of quads of `V`, grows on demand. Per vertex: 4 `V` per quad (`V::GetLayout()`),
+// indexed by the shared `0 1 2 2 3 0` pattern. Per instance: 1 `V` per quad (attributes from 1, divisor 1) drawn
+// over a static unit quad (corner xy at attribute 0)
+template<class V>
+class QuadBatch
+{
+public:
+	enum class Mode : int { perVertex = 0, perInstance = 1 };
+
+private:
+	Mode m_mode;
+	VertexBufferLayout m_layout;
+	VertexBuffer m_vertexBuffer;
+	VertexBuffer m_corners;     // per instance: unit quad
+	VertexArray  m_vao;
+	IndexBuffer  m_indexBuffer; // per vertex: `capacity` quads, per instance: one
+	std::size_t m_capacity = 0; // quads
+
+public:
+	explicit QuadBatch(Mode mode = Mode::perVertex) : QuadBatch(V::GetLayout(), mode) {}
+	QuadBatch(VertexBufferLayout layout, Mode mode) : m_mode(mode), m_layout(std::move(layout))
+	{
+		if (m_mode != Mode::perInstance) return;
+		m_layout.SetDivisor(1);
+		const float corners[] = { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f };
+		m_corners = VertexBuffer(corners, sizeof(corners));
+		const GLushort indices[] = { 0, 1, 2, 2, 3, 0 };
+		m_indexBuffer = IndexBuffer(indices, 6);
+	}
+
+	// Storage for exactly `quads` quads (contents are lost): the VAO is re-linked to the new buffer name
+	void Reserve(std::size_t quads)
+	{
+		const std::size_t vertices = m_mode == Mode::perVertex ? quads * 4 : quads;
+		m_vertexBuffer = VertexBuffer::CreateDynamic(unsigned(vertices * sizeof(V)));
+		m_vao = VertexArray::Create();
+		if (m_mode == Mode::perVertex)
+		{
+			m_vao.AddBuffer(m_vertexBuffer, m_layout);
+			m_indexBuffer = IndexBuffer::CreateQuads(unsigned(quads));
+		}
+		else
+		{
+			VertexBufferLayout corner;
+			corner.Push<float>(2); // corner xy
+			m_vao.AddBuffer(m_corners, corner);
+			m_vao.AddBuffer(m_vertexBuffer, m_layout, 1);
+		}
+		m_capacity = quads;
+	}
+
+	// Streams `quads` quads (4 or 1 `V` each), at least doubling the storage when it is too small
+	void SetData(const V *data, std::size_t quads)
+	{
+		if (quads == 0) return;
+		if (quads > m_capacity) Reserve(std::max(quads, m_capacity * 2));
+		const std::size_t vertices = m_mode == Mode::perVertex ? quads * 4 : quads;
+		m_vertexBuffer.SetData(data, unsigned(vertices * sizeof(V)));
+	}
+
+	const VertexArray &GetVertexArray() const { return m_vao; }
+	const IndexBuffer &GetIndexBuffer() const { return m_indexBuffer; }
+	std::size_t GetCapacity() const { return m_capacity; }
+	Mode GetMode() const { return m_mode; }
+};
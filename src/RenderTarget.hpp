@@ -0,0 +1,245 @@
+#pragma once
+
+#include "Utility.hpp"
+#include "GpuMemory.hpp"
+
+#include <GL/glew.h>
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+
+// What a render target is, not which one: equal descriptors are interchangeable inside `RenderTargetPool`
+struct RenderTargetDesc
+{
+	int width = 0, height = 0;
+	GLenum format = GL_RGBA8; // color attachment internal format: `GL_RGBA8`, `GL_RGBA16F`, `GL_R11F_G11F_B10F`, `GL_RG8`, `GL_R8`
+
+	bool operator==(const RenderTargetDesc &other) const { return width == other.width && height == other.height && format == other.format; }
+	bool operator!=(const RenderTargetDesc &other) const { return !(*this == other); }
+};
+
+// Framebuffer with a single sampled color texture (linear filtering, clamped): offscreen passes draw into it,
+// the next pass reads it through `BindTexture()`
+class RenderTarget
+{
+	unsigned int m_framebufferId = 0;
+	unsigned int m_textureId = 0;
+	RenderTargetDesc m_desc;
+
+public:
+	RenderTarget() {} // empty, move-assign a real one later
+	RenderTarget(const RenderTargetDesc &desc) : m_desc(desc)
+	{
+		GLenum status = GL_FRAMEBUFFER_COMPLETE;
+		if (HasDSA())
+		{
+			GLCall(glCreateTextures(GL_TEXTURE_2D, 1, &m_textureId));
+			GLCall(glTextureStorage2D(m_textureId, 1, desc.format, desc.width, desc.height));
+			GLCall(glTextureParameteri(m_textureId, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+			GLCall(glTextureParameteri(m_textureId, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+			GLCall(glTextureParameteri(m_textureId, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+			GLCall(glTextureParameteri(m_textureId, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+
+			GLCall(glCreateFramebuffers(1, &m_framebufferId));
+			GLCall(glNamedFramebufferTexture(m_framebufferId, GL_COLOR_ATTACHMENT0, m_textureId, 0));
+			GLCall(status = glCheckNamedFramebufferStatus(m_framebufferId, GL_FRAMEBUFFER));
+		}
+		else
+		{
+			const auto [format, type] = GetTransferFormat(desc.format);
+			GLCall(glGenTextures(1, &m_textureId));
+			GLCall(glBindTexture(GL_TEXTURE_2D, m_textureId));
+			GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GLint(desc.format), desc.width, desc.height, 0, format, type, nullptr));
+			GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+			GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+			GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+			GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+			GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0));
+			GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+
+			GLCall(glGenFramebuffers(1, &m_framebufferId));
+			GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferId));
+			GLCall(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_textureId, 0));
+			GLCall(status = glCheckFramebufferStatus(GL_FRAMEBUFFER));
+			GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+		}
+
+		GpuMemory::Get().Allocate(GpuMemory::Object::texture, m_textureId, GpuMemory::Category::renderTarget, GetMemorySize());
+		if (status != GL_FRAMEBUFFER_COMPLETE)
+			std::cerr << "Error: RenderTarget: incomplete framebuffer " << desc.width << 'x' << desc.height << " (status 0x" << std::hex << status << std::dec << ")" << std::endl;
+	}
+	~RenderTarget()
+	{
+		GpuMemory::Get().Free(GpuMemory::Object::texture, m_textureId);
+		GLCall(glDeleteFramebuffers(1, &m_framebufferId)); // deleting `0` is a silent no-op
+		GLCall(glDeleteTextures(1, &m_textureId));
+	}
+
+	// Move-only: the GL names are owned by exactly one object
+	RenderTarget(const RenderTarget &) = delete;
+	RenderTarget &operator=(const RenderTarget &) = delete;
+	RenderTarget(RenderTarget &&other) noexcept
+		: m_framebufferId(std::exchange(other.m_framebufferId, 0)), m_textureId(std::exchange(other.m_textureId, 0)), m_desc(other.m_desc) {}
+	RenderTarget &operator=(RenderTarget &&other) noexcept
+	{
+		std::swap(m_framebufferId, other.m_framebufferId);
+		std::swap(m_textureId, other.m_textureId);
+		std::swap(m_desc, other.m_desc);
+		return *this;
+	}
+
+	// Draw into this target: binds the framebuffer and fits the viewport to it
+	void Bind() const
+	{
+		GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferId));
+		GLCall(glViewport(0, 0, m_desc.width, m_desc.height));
+	}
+	// Back to the window, `width x height` - its framebuffer size
+	static void BindDefault(int width, int height)
+	{
+		GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+		GLCall(glViewport(0, 0, width, height));
+	}
+
+	// Read this target in the next pass
+	void BindTexture(unsigned int slot) const
+	{
+		if (HasDSA()) { GLCall(glBindTextureUnit(slot, m_textureId)); return; }
+
+		GLCall(glActiveTexture(GL_TEXTURE0 + slot));
+		GLCall(glBindTexture(GL_TEXTURE_2D, m_textureId));
+	}
+
+	const RenderTargetDesc &GetDesc() const { return m_desc; }
+	int GetWidth() const { return m_desc.width; }
+	int GetHeight() const { return m_desc.height; }
+	unsigned int GetTextureId() const { return m_textureId; }
+	size_t GetMemorySize() const { return size_t(m_desc.width) * m_desc.height * GetBytesPerPixel(m_desc.format); }
+
+	static unsigned int GetBytesPerPixel(GLenum internalFormat)
+	{
+		switch (internalFormat)
+		{
+		case GL_R8:      return 1;
+		case GL_RG8:     return 2;
+		case GL_RGBA16F: return 8;
+		default:         return 4; // `GL_RGBA8`, `GL_R11F_G11F_B10F`
+		}
+	}
+
+private:
+	// `glTexImage2D` wants a client format/type even without data (GL 3.3 path)
+	static std::pair<GLenum, GLenum> GetTransferFormat(GLenum internalFormat)
+	{
+		switch (internalFormat)
+		{
+		case GL_R8:              return { GL_RED, GL_UNSIGNED_BYTE };
+		case GL_RG8:             return { GL_RG, GL_UNSIGNED_BYTE };
+		case GL_RGBA16F:         return { GL_RGBA, GL_HALF_FLOAT };
+		case GL_R11F_G11F_B10F:  return { GL_RGB, GL_FLOAT };
+		default:                 return { GL_RGBA, GL_UNSIGNED_BYTE };
+		}
+	}
+};
+
+// Recycles render targets by descriptor instead of allocating per pass/frame:
+// - `Acquire()` hands out an idle target with an equal descriptor, creating one only when none is free
+// - `Release()` makes it idle at once: a later pass in the same frame with an equal descriptor gets the very same
+//   target, so transient targets whose lifetimes don't overlap alias one allocation
+// - `EndFrame()` releases what is still held and destroys targets left idle for `maxIdleFrames` frames (resizes, disabled passes)
+class RenderTargetPool
+{
+	struct Entry
+	{
+		RenderTarget target;
+		std::uint64_t lastUsedFrame = 0;
+		bool inUse = false;
+	};
+
+	std::vector<std::unique_ptr<Entry>> m_entries; // stable addresses: callers keep `RenderTarget &`
+	std::uint64_t m_frame = 0;
+	unsigned int m_maxIdleFrames;
+	bool m_enabled = true;
+
+	std::size_t m_acquires = 0, m_creations = 0; // this frame
+	std::size_t m_lastAcquires = 0, m_lastCreations = 0, m_inUse = 0, m_peakInUse = 0, m_lastPeakInUse = 0;
+
+public:
+	RenderTargetPool(unsigned int maxIdleFrames = 4) : m_maxIdleFrames(maxIdleFrames) {}
+
+	RenderTarget &Acquire(const RenderTargetDesc &desc)
+	{
+		m_acquires++;
+		m_peakInUse = std::max(m_peakInUse, ++m_inUse);
+
+		Entry *entry = nullptr;
+		if (m_enabled)
+			for (const std::unique_ptr<Entry> &candidate : m_entries)
+				if (!candidate->inUse && candidate->target.GetDesc() == desc) { entry = candidate.get(); break; }
+
+		if (!entry)
+		{
+			m_entries.push_back(std::make_unique<Entry>());
+			entry = m_entries.back().get();
+			entry->target = RenderTarget(desc);
+			m_creations++;
+		}
+		entry->inUse = true;
+		entry->lastUsedFrame = m_frame;
+		return entry->target;
+	}
+
+	// `target` must come from `Acquire()`: its contents stay intact until the next `Acquire()` of an equal descriptor
+	void Release(const RenderTarget &target)
+	{
+		for (const std::unique_ptr<Entry> &entry : m_entries)
+			if (&entry->target == &target)
+			{
+				ASSERT(entry->inUse);
+				entry->inUse = false;
+				m_inUse--;
+				return;
+			}
+		ASSERT(false); // not from this pool
+	}
+
+	void EndFrame()
+	{
+		for (const std::unique_ptr<Entry> &entry : m_entries)
+			entry->inUse = false;
+		m_inUse = 0;
+
+		// disabled pool: nothing survives the frame (allocate-per-frame baseline)
+		const std::uint64_t maxIdle = m_enabled ? m_maxIdleFrames : 0;
+		m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), [&](const std::unique_ptr<Entry> &entry) {
+			return m_frame - entry->lastUsedFrame >= maxIdle;
+		}), m_entries.end());
+
+		m_lastAcquires = std::exchange(m_acquires, 0);
+		m_lastCreations = std::exchange(m_creations, 0);
+		m_lastPeakInUse = std::exchange(m_peakInUse, 0);
+		m_frame++;
+	}
+
+	void Clear() { m_entries.clear(); m_inUse = 0; }
+
+	void SetEnabled(bool enabled) { m_enabled = enabled; }
+	bool IsEnabled() const { return m_enabled; }
+
+	// Statistics of the last finished frame
+	std::size_t GetAcquires() const { return m_lastAcquires; }
+	std::size_t GetCreations() const { return m_lastCreations; }
+	std::size_t GetPeakInUse() const { return m_lastPeakInUse; }
+
+	std::size_t GetCount() const { return m_entries.size(); }
+	std::size_t GetBytes() const
+	{
+		std::size_t bytes = 0;
+		for (const std::unique_ptr<Entry> &entry : m_entries) bytes += entry->target.GetMemorySize();
+		return bytes;
+	}
+};
@@ -3,20 +3,74 @@
 #include "Utility.hpp"
 #include "VertexArray.hpp"
 #include "IndexBuffer.hpp"
+#include "IndirectBuffer.hpp"
 #include "Shader.hpp"
 
 #include <GL/glew.h>
 
+#include <iostream>
+
 class Renderer
 {
 public:
-	void Clear() { GLCall(glClear(GL_COLOR_BUFFER_BIT)); }
-	void Draw(const VertexArray &va, const IndexBuffer &ib, const Shader &shader) const
+	// Depth too: depth-tested passes (`SpriteBatch`) rely on a cleared depth buffer, the clear is ~free when unused
+	void Clear() { GLCall(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT)); }
+	void Draw(const VertexArray &va, const IndexBuffer &ib, const Shader &shader) const { Draw(va, ib, shader, ib.GetCount()); }
+	// `count` indices from index `first`: batches drawing a range of a preallocated index buffer
+	void Draw(const VertexArray &va, const IndexBuffer &ib, const Shader &shader, unsigned int count, unsigned int first = 0) const
+	{
+		va.Bind();
+		ib.Bind();
+		shader.Bind();
+
+		const void *offset = reinterpret_cast<const void *>(size_t(first) * ib.GetTypeSize());
+		GLCall(glDrawElements(GL_TRIANGLES, GLsizei(count), ib.GetType(), offset));
+	}
+
+	// Full-screen pass: 3 vertices generated in the vertex shader (`Fullscreen.glsl`), `va` - any (empty) VAO, core profiles require one
+	void DrawFullscreen(const VertexArray &va, const Shader &shader) const
 	{
+		va.Bind();
+		shader.Bind();
+
+		GLCall(glDrawArrays(GL_TRIANGLES, 0, 3));
+	}
+
+	// All sub-draws of `commands` in one `glMultiDrawElementsIndirect` (GL 4.3), or one `glDrawElements*BaseVertex` each (GL 3.3)
+	// returns the number of draw API calls issued
+	unsigned int DrawIndirect(const VertexArray &va, const IndexBuffer &ib, IndirectBuffer &commands, const Shader &shader) const
+	{
+		if (commands.GetCount() == 0) return 0;
+
 		va.Bind();
 		ib.Bind();
 		shader.Bind();
 
-		GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr));
+		if (IndirectBuffer::IsSupported())
+		{
+			commands.Upload();
+			GLCall(glMultiDrawElementsIndirect(GL_TRIANGLES, ib.GetType(), nullptr, GLsizei(commands.GetCount()), 0));
+			commands.Unbind();
+			return 1;
+		}
+
+		const bool baseInstance = GLEW_VERSION_4_2 || GLEW_ARB_base_instance;
+		for (const DrawElementsIndirectCommand &command : commands.GetCommands())
+		{
+			const void *offset = reinterpret_cast<const void *>(size_t(command.firstIndex) * ib.GetTypeSize());
+			if (command.baseInstance && !baseInstance)
+			{ // instanced attributes would start at 0: per-draw data differs from the indirect path
+				static bool warned = false;
+				if (!warned) std::cerr << "Warning: DrawIndirect: baseInstance needs GL 4.2 or ARB_base_instance, ignored" << std::endl;
+				warned = true;
+			}
+			if (command.baseInstance && baseInstance)
+			{ GLCall(glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, GLsizei(command.count), ib.GetType(), offset, GLsizei(command.instanceCount), command.baseVertex, command.baseInstance)); }
+			else if (command.instanceCount == 1)
+			{ GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, GLsizei(command.count), ib.GetType(), offset, command.baseVertex)); }
+			else
+			{ GLCall(glDrawElementsInstancedBaseVertex(GL_TRIANGLES, GLsizei(command.count), ib.GetType(), offset, GLsizei(command.instanceCount), command.baseVertex)); }
+		}
+		return unsigned(commands.GetCount());
 	}
 };
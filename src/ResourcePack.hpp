@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <algorithm>
+
+// `.pack` - indexed resource archive written by `tools/ResourcePacker.cpp`
+// layout: [Header][Entry x count][names][file data...], little-endian, file data 16-byte aligned
+// entries are sorted by name (generic relative path, e.g. "res/Shaders/Basic.shader") for binary search
+namespace rpak
+{
+
+constexpr char          magic[4] = { 'R', 'P', 'A', 'K' };
+constexpr std::uint32_t version  = 1;
+constexpr std::size_t   alignment = 16;
+
+struct Header
+{
+	char          magic[4];
+	std::uint32_t version;
+	std::uint32_t count;
+	std::uint32_t namesSize; // bytes of the name table following the entries
+};
+
+struct Entry
+{
+	std::uint32_t nameOffset; // from the start of the name table
+	std::uint32_t nameSize;
+	std::uint64_t offset;     // from the start of the file
+	std::uint64_t size;
+};
+
+static_assert(sizeof(Header) == 16 && sizeof(Entry) == 24);
+
+inline const Entry *GetEntries(const Header *header) { return reinterpret_cast<const Entry *>(header + 1); }
+inline const char  *GetNames(const Header *header) { return reinterpret_cast<const char *>(GetEntries(header) + header->count); }
+
+inline std::string_view GetName(const Header *header, const Entry &entry) { return { GetNames(header) + entry.nameOffset, entry.nameSize }; }
+
+// Returns `nullptr` if `data` is not a complete, well-formed archive
+inline const Header *Validate(const void *data, std::size_t size)
+{
+	if (!data || size < sizeof(Header)) return nullptr;
+
+	const auto *header = static_cast<const Header *>(data);
+	if (std::memcmp(header->magic, magic, sizeof(magic)) != 0 || header->version != version) return nullptr;
+	if (size < sizeof(Header) + sizeof(Entry) * std::size_t(header->count) + header->namesSize) return nullptr;
+
+	const Entry *entries = GetEntries(header);
+	for (std::uint32_t i = 0; i < header->count; i++)
+		if (std::uint64_t(entries[i].nameOffset) + entries[i].nameSize > header->namesSize ||
+			entries[i].offset > size || entries[i].size > size - entries[i].offset)
+			return nullptr;
+
+	return header;
+}
+
+inline const Entry *Find(const Header *header, std::string_view name)
+{
+	const Entry *begin = GetEntries(header), *end = begin + header->count;
+	const Entry *it = std::lower_bound(begin, end, name, [header](const Entry &entry, std::string_view key) { return GetName(header, entry) < key; });
+	return it != end && GetName(header, *it) == name ? it : nullptr;
+}
+
+}
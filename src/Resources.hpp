@@ -0,0 +1,87 @@
+#pragma once
+
+#include "MappedFile.hpp"
+#include "ResourcePack.hpp"
+
+#include <iostream>
+#include <string_view>
+#include <filesystem>
+
+// Read-only bytes of one resource: a span into the mapped pack, or a separately mapped loose file
+class Resource
+{
+	MappedFile m_file; // set for loose files only
+	const unsigned char *m_data = nullptr;
+	std::size_t m_size = 0;
+
+public:
+	Resource() {}
+	Resource(const unsigned char *data, std::size_t size) : m_data(data), m_size(size) {}
+	explicit Resource(MappedFile &&file) : m_file(std::move(file)), m_data(m_file.GetData()), m_size(m_file.GetSize()) {}
+
+	explicit operator bool() const { return m_data != nullptr; }
+
+	const unsigned char *GetData() const { return m_data; }
+	std::size_t GetSize() const { return m_size; }
+	std::string_view GetText() const { return { reinterpret_cast<const char *>(m_data), m_size }; }
+};
+
+// Resolves "res/..." paths against `res.pack` (see `tools/ResourcePacker.cpp`) first, loose files second (development fallback)
+// development builds (no `NDEBUG`) also prefer a loose file edited after the pack was built; release builds trust the pack,
+// so rebuild it (`resources` target) after editing `res/`
+class Resources
+{
+	MappedFile m_packFile;
+	const rpak::Header *m_pack = nullptr;
+	std::filesystem::file_time_type m_packTime;
+
+public:
+	static constexpr const char *s_packPath = "res.pack";
+
+	static Resources &Get() { static Resources instance; return instance; }
+
+	Resource Load(const std::filesystem::path &path) const
+	{
+		if (m_pack)
+			if (const rpak::Entry *entry = rpak::Find(m_pack, path.lexically_normal().generic_string()))
+				if (!IsNewerThanPack(path))
+					return Resource(m_packFile.GetData() + entry->offset, std::size_t(entry->size));
+
+		return Resource(MappedFile(path));
+	}
+
+	bool Exists(const std::filesystem::path &path) const
+	{
+		if (m_pack && rpak::Find(m_pack, path.lexically_normal().generic_string())) return true;
+		std::error_code error;
+		return std::filesystem::is_regular_file(path, error);
+	}
+
+	bool HasPack() const { return m_pack != nullptr; }
+
+private:
+	Resources() : m_packFile(s_packPath)
+	{
+		if (!m_packFile.IsOpen()) return;
+
+		m_pack = rpak::Validate(m_packFile.GetData(), m_packFile.GetSize());
+		std::error_code error;
+		m_packTime = std::filesystem::last_write_time(s_packPath, error);
+		if (m_pack)
+			std::cout << "Info: Resources: " << s_packPath << " - " << m_pack->count << " entries\n";
+		else
+			std::cerr << "Warning: Resources: invalid pack: " << s_packPath << ", using loose files\n";
+	}
+
+	// Stale pack entry: the loose file was modified after the pack was written (one `stat` per packed load)
+	bool IsNewerThanPack([[maybe_unused]] const std::filesystem::path &path) const
+	{
+#ifndef NDEBUG
+		std::error_code error;
+		const auto time = std::filesystem::last_write_time(path, error);
+		return !error && time > m_packTime;
+#else
+		return false;
+#endif
+	}
+};
@@ -1,15 +1,23 @@
 #pragma once
 
 #include "Utility.hpp"
+#include "Resources.hpp"
 
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 
 #include <iostream>
-#include <fstream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <map>
+#include <set>
+#include <numeric>
+#include <algorithm>
+#include <cstdint>
+#include <charconv>
+#include <utility>
 #include <filesystem>
 #include <unordered_map>
 
@@ -17,47 +25,138 @@ struct ShaderProgramSource
 {
 	std::string vertexSource;
 	std::string fragmentSource;
+	std::string geometrySource;              // optional
+	std::string computeSource;               // exclusive: a compute program has no other stage
+	std::vector<std::string> feedbackVaryings; // `#feedback <varying>...`: captured interleaved by transform feedback
 };
 
+// `#define <name> <value>` lines injected after `#version` of every stage, ordered so equal sets give equal keys
+using ShaderDefines = std::map<std::string, std::string>;
+
 class Shader
 {
 	unsigned int m_RendererId = 0;
 	std::filesystem::path m_filePath;
+	ShaderDefines m_defines;
+	std::vector<int> m_textureSlots; // `0 .. MAX_TEXTURES - 1`: sampler `i` reads texture unit `i`
 	mutable std::unordered_map<std::string, int> m_locationCache;
 
 public:
-	Shader(const std::filesystem::path &filepath) : m_filePath(filepath)
+	Shader() {} // empty, move-assign a real one later
+	// One variant of `filepath` compiled with `defines` (on top of the built-in `MAX_TEXTURES` and `SAMPLE_TEXTURES`)
+	Shader(const std::filesystem::path &filepath, const ShaderDefines &defines = {}) : m_filePath(filepath), m_defines(defines)
 	{
+		const auto [maxTextures, added] = m_defines.try_emplace("MAX_TEXTURES", std::to_string(GetMaxTextureSlots()));
+		if (!added && ParseCount(maxTextures->second) <= 0)
+		{ // sizes sampler arrays and `SAMPLE_TEXTURES`: must be a plain positive integer
+			std::cerr << "Warning: " << m_filePath << ": MAX_TEXTURES \"" << maxTextures->second << "\" is not a positive integer, using " << GetMaxTextureSlots() << std::endl;
+			maxTextures->second = std::to_string(GetMaxTextureSlots());
+		}
+		m_textureSlots.resize(std::size_t(GetMaxTextures()));
+		std::iota(m_textureSlots.begin(), m_textureSlots.end(), 0);
 		ShaderProgramSource source = ParseShader(m_filePath);
-		m_RendererId = CreateShader(source.vertexSource, source.fragmentSource);
+		m_RendererId = CreateShader(source);
+	}
+	~Shader() { GLCall(glDeleteProgram(m_RendererId)); } // deleting `0` is a silent no-op
+
+	// Move-only: the GL name is owned by exactly one object
+	Shader(const Shader &) = delete;
+	Shader &operator=(const Shader &) = delete;
+	Shader(Shader &&other) noexcept
+		: m_RendererId(std::exchange(other.m_RendererId, 0)), m_filePath(std::move(other.m_filePath)), m_defines(std::move(other.m_defines)),
+		  m_textureSlots(std::move(other.m_textureSlots)), m_locationCache(std::move(other.m_locationCache)) {}
+	Shader &operator=(Shader &&other) noexcept
+	{
+		std::swap(m_RendererId, other.m_RendererId);
+		std::swap(m_filePath, other.m_filePath);
+		std::swap(m_defines, other.m_defines);
+		std::swap(m_textureSlots, other.m_textureSlots);
+		std::swap(m_locationCache, other.m_locationCache);
+		return *this;
+	}
+
+	size_t GetMemorySize() const { return 0; } // program binaries live in driver memory
+
+	// Value of an injected define (e.g. the effective `MAX_TEXTURES`), empty when not defined
+	std::string GetDefine(const std::string &name) const
+	{
+		const auto found = m_defines.find(name);
+		return found != m_defines.end() ? found->second : std::string();
+	}
+
+	// Effective `MAX_TEXTURES`: sampler array size and texture slot count of the batch shaders
+	int GetMaxTextures() const { return ParseCount(GetDefine("MAX_TEXTURES")); }
+
+	// Canonical text of the define set (sorted `name value` lines): variant cache key suffix (see `Assets::LoadShader()`)
+	// the full text, not a hash - two different sets must never share a program
+	static std::string GetDefinesKey(const ShaderDefines &defines)
+	{
+		std::string key;
+		for (const auto &[name, value] : defines) key.append(name).append(1, ' ').append(value).append(1, '\n'); // a value can't span lines
+		return key;
 	}
-	~Shader() { GLCall(glDeleteProgram(m_RendererId)); }
 
 	void Bind() const { GLCall(glUseProgram(m_RendererId)); }
 	void Unbind() const { GLCall(glUseProgram(0)); }
 
-	void SetUniform1i(const std::string &name, int value) /*                        */ { GLCall(glUniform1i(GetUniformLocation(name), value)); }
-	void SetUniform4f(const std::string &name, float v0, float v1, float v2, float v3) { GLCall(glUniform4f(GetUniformLocation(name), v0, v1, v2, v3)); }
-	void SetUniformMat4f(const std::string &name, glm::mat4 &matrix) { GLCall(glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &matrix[0][0])); }
-	void SetUniformVec1i(const std::string &name, const std::vector<int> &vector) { GLCall(glUniform1iv(GetUniformLocation(name), GLsizei(vector.size()), &vector[0])); }
+	// With DSA (`glProgramUniform*`) the program doesn't have to be bound, the bind path sets the currently bound one
+	void SetUniform1i(const std::string &name, int value)
+	{
+		if (HasDSA()) { GLCall(glProgramUniform1i(m_RendererId, GetUniformLocation(name), value)); }
+		else /*    */ { GLCall(glUniform1i(GetUniformLocation(name), value)); }
+	}
+	void SetUniform1f(const std::string &name, float value)
+	{
+		if (HasDSA()) { GLCall(glProgramUniform1f(m_RendererId, GetUniformLocation(name), value)); }
+		else /*    */ { GLCall(glUniform1f(GetUniformLocation(name), value)); }
+	}
+	void SetUniform2f(const std::string &name, float v0, float v1)
+	{
+		if (HasDSA()) { GLCall(glProgramUniform2f(m_RendererId, GetUniformLocation(name), v0, v1)); }
+		else /*    */ { GLCall(glUniform2f(GetUniformLocation(name), v0, v1)); }
+	}
+	void SetUniform3f(const std::string &name, float v0, float v1, float v2)
+	{
+		if (HasDSA()) { GLCall(glProgramUniform3f(m_RendererId, GetUniformLocation(name), v0, v1, v2)); }
+		else /*    */ { GLCall(glUniform3f(GetUniformLocation(name), v0, v1, v2)); }
+	}
+	void SetUniform4f(const std::string &name, float v0, float v1, float v2, float v3)
+	{
+		if (HasDSA()) { GLCall(glProgramUniform4f(m_RendererId, GetUniformLocation(name), v0, v1, v2, v3)); }
+		else /*    */ { GLCall(glUniform4f(GetUniformLocation(name), v0, v1, v2, v3)); }
+	}
+	void SetUniformMat4f(const std::string &name, const glm::mat4 &matrix)
+	{
+		if (HasDSA()) { GLCall(glProgramUniformMatrix4fv(m_RendererId, GetUniformLocation(name), 1, GL_FALSE, &matrix[0][0])); }
+		else /*    */ { GLCall(glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &matrix[0][0])); }
+	}
+	// Points the sampler array `name[MAX_TEXTURES]` at texture units `0 .. MAX_TEXTURES - 1` (see `SAMPLE_TEXTURES`)
+	void SetTextureSlots(const std::string &name) { SetUniformVec1i(name, m_textureSlots); }
+	const std::vector<int> &GetTextureSlots() const { return m_textureSlots; }
+	void SetUniformVec1i(const std::string &name, const std::vector<int> &vector)
+	{
+		if (HasDSA()) { GLCall(glProgramUniform1iv(m_RendererId, GetUniformLocation(name), GLsizei(vector.size()), &vector[0])); }
+		else /*    */ { GLCall(glUniform1iv(GetUniformLocation(name), GLsizei(vector.size()), &vector[0])); }
+	}
 
 private:
 	ShaderProgramSource ParseShader(const std::filesystem::path &filePath)
 	{
-		enum class ShaderType { none = -1, vertex = 0, fragment = 1 };
+		enum class ShaderType { none = -1, vertex = 0, fragment = 1, geometry = 2, compute = 3 };
 
-		std::ifstream stream(filePath);
-		if (!stream)
+		const Resource file = Resources::Get().Load(filePath);
+		if (!file)
 		{
 			std::cerr << "Error: Fail to open shader path: " << filePath << std::endl;
 			exit(EXIT_FAILURE);
 		}
 
-		std::string line;
-		std::stringstream ss[2];
+		std::string_view text = file.GetText(), line;
+		std::string sources[4];
+		std::vector<std::string> varyings;
 		ShaderType type = ShaderType::none;
 
-		while (getline(stream, line))
+		while (NextLine(text, line))
 		{
 			if (line.find("#shader") != std::string::npos)
 			{
@@ -65,13 +164,119 @@ private:
 					type = ShaderType::vertex;
 				else if (line.find("fragment") != std::string::npos)
 					type = ShaderType::fragment;
+				else if (line.find("geometry") != std::string::npos)
+					type = ShaderType::geometry;
+				else if (line.find("compute") != std::string::npos)
+					type = ShaderType::compute;
+			}
+			else if (line.rfind("#feedback", 0) == 0)
+			{
+				std::istringstream names{ std::string(line.substr(9)) };
+				for (std::string name; names >> name;)
+					varyings.push_back(name);
+			}
+			else if (type != ShaderType::none)
+			{
+				sources[static_cast<int>(type)].append(line).append("\n");
+			}
+		}
+		const auto preprocess = [&](const std::string &source) { return source.empty() ? source : Preprocess(source, filePath); };
+		return { preprocess(sources[0]), preprocess(sources[1]), preprocess(sources[2]), preprocess(sources[3]), std::move(varyings) };
+	}
+
+	// Expands includes and injects the defines right after `#version` (it must stay the first directive)
+	std::string Preprocess(const std::string &source, const std::filesystem::path &filePath) const
+	{
+		std::string out;
+		std::set<std::string> included = { filePath.lexically_normal().generic_string() };
+		ExpandIncludes(source, filePath, out, included);
+
+		return out.insert(FindAfterVersion(out), GetDefinesSource());
+	}
+
+	// Offset of the line after the `#version` directive (leading whitespace and `# version` allowed), 0 without one
+	static size_t FindAfterVersion(std::string_view source)
+	{
+		std::string_view text = source, line;
+		while (NextLine(text, line))
+		{
+			size_t first = line.find_first_not_of(" \t");
+			if (first == std::string_view::npos || line[first] != '#') continue;
+			first = line.find_first_not_of(" \t", first + 1);
+			if (first != std::string_view::npos && line.compare(first, 7, "version") == 0)
+				return text.empty() ? source.size() : size_t(text.data() - source.data());
+		}
+		return 0;
+	}
+
+	// Positive decimal count, 0 when `text` isn't one
+	static int ParseCount(const std::string &text)
+	{
+		int count = 0;
+		const char *end = text.data() + text.size();
+		const auto [last, error] = std::from_chars(text.data(), end, count);
+		return error == std::errc() && last == end && count > 0 ? count : 0;
+	}
+
+	// Inlines `#include "file"` (relative to the including file) into `out`, each file at most once per stage
+	static void ExpandIncludes(std::string_view text, const std::filesystem::path &filePath, std::string &out, std::set<std::string> &included)
+	{
+		std::string_view line;
+		while (NextLine(text, line))
+		{
+			const size_t first = line.find_first_not_of(" \t");
+			if (first == std::string_view::npos || line.compare(first, 8, "#include") != 0)
+			{
+				out.append(line).append("\n");
+				continue;
 			}
-			else
+
+			const size_t open = line.find('"'), close = line.rfind('"');
+			if (open == close)
+			{
+				std::cerr << "Warning: malformed shader include in " << filePath << ": " << line << std::endl;
+				continue;
+			}
+
+			const std::filesystem::path include = (filePath.parent_path() / line.substr(open + 1, close - open - 1)).lexically_normal();
+			if (!included.insert(include.generic_string()).second) continue; // `#pragma once` semantics, also breaks cycles
+
+			const Resource file = Resources::Get().Load(include);
+			if (!file)
 			{
-				ss[static_cast<int>(type)] << line << '\n';
+				std::cerr << "Error: Fail to open shader include: " << include << " (from " << filePath << ")" << std::endl;
+				continue;
 			}
+			ExpandIncludes(file.GetText(), include, out, included);
 		}
-		return { ss[0].str(), ss[1].str() };
+	}
+
+	// Injected `#define`s plus `SAMPLE_TEXTURES(samplers, index, uv, result)`: GLSL 3.30 only allows constant sampler
+	// array indices, so the switch over `MAX_TEXTURES` cases is generated here (single line - no `\` continuation in 3.30)
+	std::string GetDefinesSource() const
+	{
+		std::string source;
+		for (const auto &[name, value] : m_defines)
+			source += "#define " + name + ' ' + value + '\n';
+
+		source += "#define SAMPLE_TEXTURES(samplers, index, uv, result) switch (index) {";
+		const int count = GetMaxTextures();
+		for (int i = 0; i < count; i++)
+			source += " case " + std::to_string(i) + ": result = texture(samplers[" + std::to_string(i) + "], uv); break;";
+		source += " }\n";
+		return source;
+	}
+
+	// Pops the first line (without `\n` and `\r`) from `text`
+	static bool NextLine(std::string_view &text, std::string_view &line)
+	{
+		if (text.empty()) return false;
+
+		const size_t end = text.find('\n');
+		line = text.substr(0, end);
+		text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+		if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+		return true;
 	}
 
 	unsigned int CompileShader(unsigned int type, const std::string &source)
@@ -92,7 +297,7 @@ private:
 			char *message = static_cast<char *>(alloca(length * sizeof(char)));
 			GLCall(glGetShaderInfoLog(shader, length, nullptr, message));
 
-			std::cerr << "Error: Fail to compile " << (type == GL_VERTEX_SHADER ? "vertex" : "fragment") << " shader\n";
+			std::cerr << "Error: Fail to compile " << GetStageName(type) << " shader: " << m_filePath << '\n';
 			std::cerr << message << std::endl;
 
 			GLCall(glDeleteShader(shader));
@@ -102,24 +307,68 @@ private:
 		return shader;
 	}
 
-	unsigned int CreateShader(const std::string &vertexShader, const std::string &fragmentShader)
+	// Links the present stages: compute alone, or vertex + optional geometry/fragment (no fragment - transform feedback only)
+	unsigned int CreateShader(const ShaderProgramSource &source)
 	{
 		unsigned int program;
 		GLCall(program = glCreateProgram());
-		unsigned int vs = CompileShader(GL_VERTEX_SHADER, vertexShader);
-		unsigned int fs = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
 
-		GLCall(glAttachShader(program, vs));
-		GLCall(glAttachShader(program, fs));
+		std::vector<unsigned int> shaders;
+		const auto attach = [&](unsigned int type, const std::string &stage) {
+			if (stage.empty()) return;
+			shaders.push_back(CompileShader(type, stage));
+			GLCall(glAttachShader(program, shaders.back()));
+		};
+		if (!source.computeSource.empty())
+		{
+			attach(GL_COMPUTE_SHADER, source.computeSource);
+		}
+		else
+		{
+			attach(GL_VERTEX_SHADER, source.vertexSource);
+			attach(GL_GEOMETRY_SHADER, source.geometrySource);
+			attach(GL_FRAGMENT_SHADER, source.fragmentSource);
+		}
+
+		if (!source.feedbackVaryings.empty())
+		{ // must be declared before linking
+			std::vector<const char *> names;
+			for (const std::string &name : source.feedbackVaryings)
+				names.push_back(name.c_str());
+			GLCall(glTransformFeedbackVaryings(program, GLsizei(names.size()), names.data(), GL_INTERLEAVED_ATTRIBS));
+		}
+
 		GLCall(glLinkProgram(program));
+		int linked;
+		GLCall(glGetProgramiv(program, GL_LINK_STATUS, &linked));
+		if (linked == GL_FALSE)
+		{
+			int length;
+			GLCall(glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length));
+			std::string message(size_t(std::max(length, 1)), '\0');
+			GLCall(glGetProgramInfoLog(program, length, nullptr, message.data()));
+			std::cerr << "Error: Fail to link shader: " << m_filePath << '\n' << message << std::endl;
+		}
 		GLCall(glValidateProgram(program));
 
-		GLCall(glDeleteShader(vs));
-		GLCall(glDeleteShader(fs));
+		for (const unsigned int shader : shaders)
+		{ GLCall(glDeleteShader(shader)); }
 
 		return program;
 	}
 
+	static const char *GetStageName(unsigned int type)
+	{
+		switch (type)
+		{
+		case GL_VERTEX_SHADER:   return "vertex";
+		case GL_FRAGMENT_SHADER: return "fragment";
+		case GL_GEOMETRY_SHADER: return "geometry";
+		case GL_COMPUTE_SHADER:  return "compute";
+		default:                 return "unknown";
+		}
+	}
+
 	int GetUniformLocation(const std::string &name) const
 	{
 		if (const auto cache = m_locationCache.find(name); cache != m_locationCache.end())
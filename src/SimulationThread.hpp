@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Utility.hpp"
+
+#include <imgui/imgui.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+
+// Fixed-rate update loop on its own thread: the GL thread renders the last published state while the next one is
+// simulated, update time no longer adds to frame latency. The callback never touches GL or ImGui, it hands its
+// results over through a `FrameState` (see `test::Test::SupportsThreadedUpdate()`)
+class SimulationThread
+{
+public:
+	using clock_t   = std::chrono::steady_clock;
+	using seconds_t = std::chrono::duration<double>;
+
+private:
+	static constexpr int s_maxBehind = 8; // steps; further behind - drop the backlog like `FrameTimer::Step()`
+
+	std::thread m_thread;
+	std::atomic<bool> m_running{ false };
+	std::atomic<float> m_step{ 1.0f / 120.0f };
+	std::atomic<float> m_updateTime{ 0.0f }; // smoothed [ms]
+	std::atomic<float> m_rate{ 0.0f };       // steps actually taken per second
+	std::atomic<std::uint64_t> m_steps{ 0 };
+
+public:
+	SimulationThread() {}
+	~SimulationThread() { Stop(); }
+	SimulationThread(const SimulationThread &) = delete;
+	SimulationThread &operator=(const SimulationThread &) = delete;
+
+	void Start(std::function<void(float)> update, float step)
+	{
+		Stop();
+		m_step = step;
+		m_steps = 0;
+		m_running = true;
+		m_thread = std::thread([this, update = std::move(update)]() { Run(update); });
+		std::cout << "Info: SimulationThread: started" << std::endl;
+	}
+	// Blocks until the current step is done; the callback is not called after this returns
+	void Stop()
+	{
+		if (!m_thread.joinable()) return;
+		m_running = false;
+		m_thread.join();
+		std::cout << "Info: SimulationThread: stopped after " << m_steps.load() << " steps" << std::endl;
+	}
+
+	bool IsRunning() const { return m_thread.joinable(); }
+	void SetStep(float step) { m_step = step; }
+	std::uint64_t GetSteps() const { return m_steps; }
+
+	void OnImGuiRender()
+	{
+		if (!IsRunning()) return;
+		ImGui::Text("Simulation thread: update %.3f ms, %.0f steps/s", double(m_updateTime.load()), double(m_rate.load()));
+	}
+
+private:
+	void Run(const std::function<void(float)> &update)
+	{
+		auto next = clock_t::now(), second = next;
+		int stepsThisSecond = 0;
+		float updateTime = 0.0f;
+		while (m_running.load(std::memory_order_relaxed))
+		{
+			const float step = m_step;
+			const auto start = clock_t::now();
+			update(step);
+			const auto end = clock_t::now();
+			updateTime += (float(seconds_t(end - start).count()) * 1000.0f - updateTime) * 0.1f;
+			m_updateTime.store(updateTime, std::memory_order_relaxed);
+			m_steps.fetch_add(1, std::memory_order_relaxed);
+
+			stepsThisSecond++;
+			if (end - second >= std::chrono::seconds(1))
+			{
+				m_rate.store(float(stepsThisSecond / seconds_t(end - second).count()), std::memory_order_relaxed);
+				second = end;
+				stepsThisSecond = 0;
+			}
+
+			const auto period = std::chrono::duration_cast<clock_t::duration>(seconds_t(step));
+			next += period;
+			if (next < end - period * s_maxBehind) next = end; // can't keep up: simulation slows down
+			if (next > end) std::this_thread::sleep_until(next);
+		}
+	}
+};
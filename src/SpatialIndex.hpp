@@ -0,0 +1,285 @@
+#pragma once
+
+#include "Utility.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+
+// Axis-aligned rectangle, world units
+struct Bounds
+{
+	glm::vec2 min = glm::vec2(0.0f);
+	glm::vec2 max = glm::vec2(0.0f);
+
+	bool Overlaps(const Bounds &other) const { return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y; }
+	glm::vec2 GetCenter() const { return (min + max) * 0.5f; }
+	glm::vec2 GetSize() const { return max - min; }
+};
+
+// 2D broad phase over small dense ids (e.g. `SpriteScene` handles)
+// queries append each overlapping id exactly once and are exact (candidates are bounds-tested)
+class SpatialIndex
+{
+public:
+	using Id = std::uint32_t;
+
+	virtual ~SpatialIndex() {}
+
+	virtual void Insert(Id id, const Bounds &bounds) = 0;
+	virtual void Remove(Id id) = 0;
+	virtual void Move(Id id, const Bounds &bounds) = 0; // cheap while the item stays in the same cells/node
+	virtual void Query(const Bounds &area, std::vector<Id> &out) const = 0;
+	virtual void Clear() = 0;
+	virtual const char *GetName() const = 0;
+
+	void QueryPoint(glm::vec2 point, std::vector<Id> &out) const { Query({ point, point }, out); }
+};
+
+// Baseline: every query tests every item - cost scales with world population
+class LinearIndex : public SpatialIndex
+{
+	std::vector<Bounds> m_bounds;
+	std::vector<bool> m_present;
+
+public:
+	void Insert(Id id, const Bounds &bounds) override
+	{
+		if (id >= m_bounds.size()) { m_bounds.resize(id + 1); m_present.resize(id + 1); }
+		m_bounds[id] = bounds;
+		m_present[id] = true;
+	}
+	void Remove(Id id) override { m_present[id] = false; }
+	void Move(Id id, const Bounds &bounds) override { m_bounds[id] = bounds; }
+	void Query(const Bounds &area, std::vector<Id> &out) const override
+	{
+		for (Id id = 0; id < m_bounds.size(); id++)
+			if (m_present[id] && m_bounds[id].Overlaps(area)) out.push_back(id);
+	}
+	void Clear() override { m_bounds.clear(); m_present.clear(); }
+	const char *GetName() const override { return "Linear (no index)"; }
+};
+
+// Uniform grid hashed into a sparse map: unbounded world, items spanning several cells are listed in each
+// best when items are about the cell size
+class SpatialHashGrid : public SpatialIndex
+{
+	struct Item
+	{
+		Bounds bounds;
+		glm::ivec2 cellMin = glm::ivec2(0), cellMax = glm::ivec2(-1); // empty range - not present
+	};
+
+	float m_cellSize;
+	std::vector<Item> m_items;
+	std::unordered_map<std::uint64_t, std::vector<Id>> m_cells;
+	mutable std::vector<std::uint32_t> m_stamps; // per id: last query that reported it (multi-cell duplicates)
+	mutable std::uint32_t m_stamp = 0;
+
+public:
+	SpatialHashGrid(float cellSize = 64.0f) : m_cellSize(cellSize) {}
+
+	void Insert(Id id, const Bounds &bounds) override
+	{
+		if (id >= m_items.size()) { m_items.resize(id + 1); m_stamps.resize(id + 1, 0); }
+		Item &item = m_items[id];
+		item.bounds = bounds;
+		item.cellMin = GetCell(bounds.min);
+		item.cellMax = GetCell(bounds.max);
+		ForEachCell(item.cellMin, item.cellMax, [&](std::uint64_t key) { m_cells[key].push_back(id); });
+	}
+	void Remove(Id id) override
+	{
+		Item &item = m_items[id];
+		ForEachCell(item.cellMin, item.cellMax, [&](std::uint64_t key) {
+			const auto bucket = m_cells.find(key);
+			if (bucket == m_cells.end()) return;
+			std::vector<Id> &cell = bucket->second;
+			const auto found = std::find(cell.begin(), cell.end(), id);
+			if (found == cell.end()) return;
+			*found = cell.back(); // swap-remove, cell order doesn't matter
+			cell.pop_back();
+			if (cell.empty()) m_cells.erase(bucket); // only occupied cells stay in the map
+		});
+		item.cellMin = glm::ivec2(0);
+		item.cellMax = glm::ivec2(-1);
+	}
+	void Move(Id id, const Bounds &bounds) override
+	{
+		Item &item = m_items[id];
+		if (GetCell(bounds.min) == item.cellMin && GetCell(bounds.max) == item.cellMax)
+		{
+			item.bounds = bounds; // same cells: no bucket traffic
+			return;
+		}
+		Remove(id);
+		Insert(id, bounds);
+	}
+	void Query(const Bounds &area, std::vector<Id> &out) const override
+	{
+		if (++m_stamp == 0) // wrapped: old stamps could collide
+		{
+			std::fill(m_stamps.begin(), m_stamps.end(), 0);
+			m_stamp = 1;
+		}
+
+		const auto visit = [&](const std::vector<Id> &cell) {
+			for (const Id id : cell)
+			{
+				if (m_stamps[id] == m_stamp) continue;
+				m_stamps[id] = m_stamp;
+				if (m_items[id].bounds.Overlaps(area)) out.push_back(id);
+			}
+		};
+
+		const glm::ivec2 cellMin = GetCell(area.min), cellMax = GetCell(area.max);
+		const double cellCount = double(cellMax.x - cellMin.x + 1) * double(cellMax.y - cellMin.y + 1);
+		if (cellCount > double(m_cells.size())) // huge area: walking the occupied buckets is cheaper than probing empty ones
+		{
+			for (const auto &[key, cell] : m_cells) visit(cell);
+			return;
+		}
+		ForEachCell(cellMin, cellMax, [&](std::uint64_t key) {
+			if (const auto found = m_cells.find(key); found != m_cells.end()) visit(found->second);
+		});
+	}
+	void Clear() override { m_items.clear(); m_cells.clear(); m_stamps.clear(); }
+	const char *GetName() const override { return "Spatial hash grid"; }
+
+	float GetCellSize() const { return m_cellSize; }
+
+private:
+	glm::ivec2 GetCell(glm::vec2 point) const { return glm::ivec2(glm::floor(point / m_cellSize)); }
+
+	template<class F>
+	static void ForEachCell(glm::ivec2 cellMin, glm::ivec2 cellMax, F &&function)
+	{
+		for (int y = cellMin.y; y <= cellMax.y; y++)
+			for (int x = cellMin.x; x <= cellMax.x; x++)
+				function((std::uint64_t(std::uint32_t(x)) << 32) | std::uint32_t(y));
+	}
+};
+
+// Loose quadtree stored as a pyramid of dense grids: every item lives in exactly one node - the deepest level whose
+// cell is at least as large as the item, picked by the item's center (nodes are "loose": their bounds are doubled,
+// so items never straddle). Queries expand the area by half a cell per level; items centered outside the world are kept aside
+class LooseQuadtree : public SpatialIndex
+{
+	static constexpr std::uint32_t s_outside = ~0u;
+
+public:
+	static constexpr int s_maxDepth = 8; // every node is allocated up front: 87381 lists at depth 8, 4x more per level
+
+private:
+
+	struct Item
+	{
+		Bounds bounds;
+		std::uint32_t node = s_outside;
+		std::uint32_t slot = 0; // position in the node's list: O(1) swap-remove
+		bool present = false;
+	};
+
+	Bounds m_world;
+	int m_depth;
+	std::vector<Item> m_items;
+	std::vector<std::vector<Id>> m_nodes; // level `l` starts at `(4^l - 1) / 3`, `2^l x 2^l` row-major cells
+	std::vector<Id> m_outside;
+
+public:
+	LooseQuadtree(const Bounds &world, int depth = 8) : m_world(world), m_depth(std::clamp(depth, 0, s_maxDepth))
+	{
+		m_nodes.resize(GetLevelOffset(m_depth + 1));
+	}
+
+	void Insert(Id id, const Bounds &bounds) override
+	{
+		if (id >= m_items.size()) m_items.resize(id + 1);
+		Item &item = m_items[id];
+		item.bounds = bounds;
+		item.node = GetNode(bounds);
+		item.present = true;
+
+		std::vector<Id> &list = item.node == s_outside ? m_outside : m_nodes[item.node];
+		item.slot = std::uint32_t(list.size());
+		list.push_back(id);
+	}
+	void Remove(Id id) override
+	{
+		Item &item = m_items[id];
+		std::vector<Id> &list = item.node == s_outside ? m_outside : m_nodes[item.node];
+		const Id last = list.back();
+		list[item.slot] = last;
+		m_items[last].slot = item.slot;
+		list.pop_back();
+		item.present = false;
+	}
+	void Move(Id id, const Bounds &bounds) override
+	{
+		Item &item = m_items[id];
+		if (GetNode(bounds) == item.node)
+		{
+			item.bounds = bounds;
+			return;
+		}
+		Remove(id);
+		Insert(id, bounds);
+	}
+	void Query(const Bounds &area, std::vector<Id> &out) const override
+	{
+		const auto visit = [&](const std::vector<Id> &list) {
+			for (const Id id : list)
+				if (m_items[id].bounds.Overlaps(area)) out.push_back(id);
+		};
+
+		const glm::vec2 worldSize = m_world.GetSize();
+		for (int level = 0; level <= m_depth; level++)
+		{
+			const int cells = 1 << level;
+			const glm::vec2 cellSize = worldSize / float(cells);
+			// a node's items reach at most half a cell past it: widen the area accordingly
+			const glm::ivec2 cellMin = glm::clamp(glm::ivec2(glm::floor((area.min - cellSize * 0.5f - m_world.min) / cellSize)), 0, cells - 1);
+			const glm::ivec2 cellMax = glm::clamp(glm::ivec2(glm::floor((area.max + cellSize * 0.5f - m_world.min) / cellSize)), 0, cells - 1);
+			const Bounds loose = { m_world.min - cellSize * 0.5f, m_world.max + cellSize * 0.5f };
+			if (level > 0 && !loose.Overlaps(area)) continue; // the root is always visited: it also holds items larger than the world
+
+			const std::size_t offset = GetLevelOffset(level);
+			for (int y = cellMin.y; y <= cellMax.y; y++)
+				for (int x = cellMin.x; x <= cellMax.x; x++)
+					visit(m_nodes[offset + std::size_t(y) * cells + x]);
+		}
+		visit(m_outside);
+	}
+	void Clear() override
+	{
+		m_items.clear();
+		m_outside.clear();
+		for (std::vector<Id> &node : m_nodes) node.clear();
+	}
+	const char *GetName() const override { return "Loose quadtree"; }
+
+	int GetDepth() const { return m_depth; }
+
+private:
+	static std::size_t GetLevelOffset(int level) { return ((std::size_t(1) << (2 * level)) - 1) / 3; }
+
+	std::uint32_t GetNode(const Bounds &bounds) const
+	{
+		const glm::vec2 center = bounds.GetCenter(), size = bounds.GetSize();
+		if (center.x < m_world.min.x || center.y < m_world.min.y || center.x >= m_world.max.x || center.y >= m_world.max.y)
+			return s_outside;
+
+		const glm::vec2 worldSize = m_world.GetSize();
+		int level = m_depth;
+		while (level > 0 && (size.x > worldSize.x / float(1 << level) || size.y > worldSize.y / float(1 << level)))
+			level--;
+
+		const int cells = 1 << level;
+		const glm::ivec2 cell = glm::clamp(glm::ivec2((center - m_world.min) / worldSize * float(cells)), 0, cells - 1);
+		return std::uint32_t(GetLevelOffset(level) + std::size_t(cell.y) * cells + cell.x);
+	}
+};
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "Utility.hpp"
+#include "Renderer.hpp"
+#include "QuadBatch.hpp"
+#include "Assets.hpp"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+// `Vertex` with a depth: `Batch-Textures.shader` reads `position` as `vec4`, the third component lands in `z`
+struct DepthVertex {
+	std::array<float, 3> position{ 0.0f, 0.0f, 0.0f }; // xyz
+	std::array<float, 4> color{ 0.0f, 0.0f, 0.0f, 0.0f };
+	std::array<float, 2> texcoord{ 0.0f, 0.0f };
+	float texId{ 0.f };
+
+	static VertexBufferLayout GetLayout()
+	{
+		VertexBufferLayout layout;
+		layout.Push<float>(3); // coord xyz
+		layout.Push<float>(4); // color rgba
+		layout.Push<float>(2); // texcoord xy
+		layout.Push<float>(1); // texidx <idx>
+		return layout;
+	}
+};
+
+static_assert(sizeof(DepthVertex) == 10 * sizeof(float));
+
+// Sprite batch with an opaque/translucent split:
+// - `Mode::blended` - everything alpha-blended back-to-front (painter's order, every layer shaded: full overdraw)
+// - `Mode::split`   - opaque sprites (opaque texture and alpha 1) first, front-to-back with depth test/write and
+//                     blending off: early depth rejects whatever is hidden; then translucent ones back-to-front,
+//                     depth-tested against the opaque layer without writing depth
+// `depth` in [0, 1), larger is in front; needs a depth buffer cleared to 1 and a projection with near -1/far 1
+class SpriteBatch
+{
+public:
+	enum class Mode : int { blended = 0, split = 1 };
+
+	struct Sprite
+	{
+		glm::vec2 position = glm::vec2(0.0f); // bottom-left
+		glm::vec2 size = glm::vec2(1.0f);
+		glm::vec4 color = glm::vec4(1.0f);
+		float texId = 0.0f;
+		float depth = 0.0f;
+	};
+
+	// Fragments shaded by the last measured frame (`GL_SAMPLES_PASSED`)
+	struct Samples { std::uint64_t opaque = 0, translucent = 0; };
+
+private:
+	static constexpr int s_latency = 4; // frames of queries in flight
+
+	std::vector<Sprite> m_sprites;
+	std::vector<std::pair<float, std::uint32_t>> m_opaque, m_translucent; // sort keys: (depth, submission index)
+	std::vector<char> m_opaqueTextures; // per texture slot: no texel with alpha < 1
+	Mode m_mode = Mode::split;
+	bool m_overdraw = false;
+
+	std::vector<DepthVertex> m_vertices;
+	QuadBatch<DepthVertex> m_batch;
+	AssetRef<Shader> m_shader, m_overdrawShader;
+
+	unsigned int m_queries[s_latency][2] = {};
+	int m_next = 0, m_pending = 0;
+	Samples m_samples;
+	std::size_t m_opaqueCount = 0, m_translucentCount = 0;
+
+public:
+	SpriteBatch()
+	{
+		m_shader = Assets::LoadShader("res/Shaders/Batch-Textures.shader");
+		m_overdrawShader = Assets::LoadShader("res/Shaders/Overdraw.shader");
+		m_opaqueTextures.resize(std::size_t(m_shader->GetMaxTextures()), 0);
+		GLCall(glGenQueries(s_latency * 2, &m_queries[0][0]));
+	}
+	~SpriteBatch() { GLCall(glDeleteQueries(s_latency * 2, &m_queries[0][0])); }
+
+	SpriteBatch(const SpriteBatch &) = delete;
+	SpriteBatch &operator=(const SpriteBatch &) = delete;
+
+	// Sprites sampling `slot` may skip blending when their color alpha is 1 (the caller knows the texture contents)
+	void SetTextureOpaque(unsigned int slot, bool opaque) { if (slot < m_opaqueTextures.size()) m_opaqueTextures[slot] = opaque; }
+
+	void Add(const Sprite &sprite) { m_sprites.push_back(sprite); }
+	void Reserve(std::size_t sprites) { m_sprites.reserve(sprites); }
+
+	// Draws and empties the batch: textures must be bound to their slots, `mvp` maps `depth` into clip space unchanged
+	void Flush(const Renderer &renderer, const glm::mat4 &mvp)
+	{
+		Classify();
+		const std::size_t quads = m_sprites.size();
+		m_sprites.clear();
+		if (quads == 0) return;
+		m_batch.SetData(m_vertices.data(), quads);
+
+		Shader &shader = m_overdraw ? *m_overdrawShader : *m_shader;
+		shader.Bind();
+		shader.SetUniformMat4f("u_MVP", mvp);
+		if (m_overdraw)
+		{
+			shader.SetUniform4f("u_Increment", 0.0625f, 0.025f, 0.008f, 1.0f); // 16 layers saturate red
+			GLCall(glBlendFunc(GL_ONE, GL_ONE));
+		}
+		else
+			shader.SetTextureSlots("u_Textures");
+
+		Collect();
+		if (m_pending == s_latency) m_pending--; // still not ready: drop the oldest result, its queries get reused
+		unsigned int *queries = m_queries[m_next];
+
+		// opaque: nearest first, depth written, nothing blended (the overdraw view keeps additive blending on)
+		GLCall(glEnable(GL_DEPTH_TEST));
+		GLCall(glDepthFunc(GL_LESS));
+		GLCall(glBeginQuery(GL_SAMPLES_PASSED, queries[0]));
+		if (m_opaqueCount)
+		{
+			if (!m_overdraw) { GLCall(glDisable(GL_BLEND)); }
+			renderer.Draw(m_batch.GetVertexArray(), m_batch.GetIndexBuffer(), shader, unsigned(m_opaqueCount * 6));
+			GLCall(glEnable(GL_BLEND));
+		}
+		GLCall(glEndQuery(GL_SAMPLES_PASSED));
+
+		// translucent: farthest first, tested against the opaque depth, not written (they don't occlude each other)
+		GLCall(glDepthMask(GL_FALSE));
+		GLCall(glBeginQuery(GL_SAMPLES_PASSED, queries[1]));
+		if (m_translucentCount)
+			renderer.Draw(m_batch.GetVertexArray(), m_batch.GetIndexBuffer(), shader, unsigned(m_translucentCount * 6), unsigned(m_opaqueCount * 6));
+		GLCall(glEndQuery(GL_SAMPLES_PASSED));
+		GLCall(glDepthMask(GL_TRUE));
+		GLCall(glDisable(GL_DEPTH_TEST));
+		if (m_overdraw) { GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA)); }
+
+		m_next = (m_next + 1) % s_latency;
+		m_pending++;
+	}
+
+	void SetMode(Mode mode) { m_mode = mode; }
+	Mode GetMode() const { return m_mode; }
+	void SetOverdrawView(bool enabled) { m_overdraw = enabled; }
+	bool IsOverdrawView() const { return m_overdraw; }
+
+	// Last flush
+	std::size_t GetOpaqueCount() const { return m_opaqueCount; }
+	std::size_t GetTranslucentCount() const { return m_translucentCount; }
+	// A few frames late
+	const Samples &GetSamples() const { return m_samples; }
+
+private:
+	// Splits and orders the sprites, writes opaque quads then translucent ones into `m_vertices`
+	void Classify()
+	{
+		m_opaque.clear();
+		m_translucent.clear();
+		for (std::uint32_t i = 0; i < m_sprites.size(); i++)
+		{
+			const Sprite &sprite = m_sprites[i];
+			const std::size_t slot = std::size_t(sprite.texId);
+			const bool opaque = m_mode == Mode::split && sprite.color.w >= 1.0f && slot < m_opaqueTextures.size() && m_opaqueTextures[slot];
+			(opaque ? m_opaque : m_translucent).push_back({ sprite.depth, i });
+		}
+		// equal depth: the later submission wins in both passes, as in painter's order
+		std::sort(m_opaque.begin(), m_opaque.end(), [](const auto &a, const auto &b) { return a > b; });
+		std::sort(m_translucent.begin(), m_translucent.end());
+		m_opaqueCount = m_opaque.size();
+		m_translucentCount = m_translucent.size();
+
+		m_vertices.resize(m_sprites.size() * 4);
+		DepthVertex *vertex = m_vertices.data();
+		for (const auto *keys : { &m_opaque, &m_translucent })
+			for (const auto &[depth, index] : *keys)
+			{
+				const Sprite &sprite = m_sprites[index];
+				const float x0 = sprite.position.x, y0 = sprite.position.y, x1 = x0 + sprite.size.x, y1 = y0 + sprite.size.y;
+				const std::array<float, 4> color = { sprite.color.x, sprite.color.y, sprite.color.z, sprite.color.w };
+				*vertex++ = { { x0, y0, depth }, color, { 0.0f, 0.0f }, sprite.texId };
+				*vertex++ = { { x1, y0, depth }, color, { 1.0f, 0.0f }, sprite.texId };
+				*vertex++ = { { x1, y1, depth }, color, { 1.0f, 1.0f }, sprite.texId };
+				*vertex++ = { { x0, y1, depth }, color, { 0.0f, 1.0f }, sprite.texId };
+			}
+	}
+
+	// Reads finished sample counts oldest first, stops at the first frame still in flight
+	void Collect()
+	{
+		while (m_pending > 0)
+		{
+			const unsigned int *queries = m_queries[(m_next - m_pending + s_latency) % s_latency];
+			GLint available = 0;
+			GLCall(glGetQueryObjectiv(queries[1], GL_QUERY_RESULT_AVAILABLE, &available)); // ended last
+			if (!available) break;
+
+			GLuint64 opaque = 0, translucent = 0;
+			GLCall(glGetQueryObjectui64v(queries[0], GL_QUERY_RESULT, &opaque));
+			GLCall(glGetQueryObjectui64v(queries[1], GL_QUERY_RESULT, &translucent));
+			m_samples = { opaque, translucent };
+			m_pending--;
+		}
+	}
+};
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "Utility.hpp"
+#include "Renderer.hpp"
+#include "VertexArray.hpp"
+#include "VertexBuffer.hpp"
+#include "VertexBufferLayout.hpp"
+#include "IndexBuffer.hpp"
+#include "IndirectBuffer.hpp"
+#include "Shader.hpp"
+#include "Assets.hpp"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define SPRITE_CULLER_SSE2 1
+#endif
+
+#include <vector>
+
+// Instanced sprites drawn with one indirect call, with off-screen sprites culled before they reach the vertex stage:
+// on the GPU (compute pass appends survivors and writes the instance count into the indirect command - no readback),
+// or on the CPU (SSE2, 4 sprites per test) uploading only the survivors
+class SpriteCuller
+{
+public:
+	// Matches `struct Sprite` (std430) in `Sprite-Cull.shader` and the instance attributes of `Sprite-Instanced.shader`
+	struct Sprite
+	{
+		glm::vec2 position; // bottom-left corner, world units
+		glm::vec2 size;
+		glm::vec4 color;
+	};
+	static_assert(sizeof(Sprite) == 8 * 4);
+
+	enum class Mode : int { gpu = 0, cpu = 1, none = 2 };
+
+	static constexpr unsigned int s_groupSize = 256; // `local_size_x` of the compute shader
+
+private:
+	std::vector<Sprite> m_sprites;
+	std::vector<float> m_minX, m_minY, m_maxX, m_maxY; // SoA copy of the bounds: 4 sprites per SSE2 compare
+	std::vector<Sprite> m_visible; // CPU path: compacted survivors
+
+	VertexBuffer m_quad;          // unit quad corners, per vertex
+	VertexBuffer m_allBuffer;     // every sprite: compute input and `Mode::none` instances
+	VertexBuffer m_visibleBuffer; // compacted survivors (GPU- or CPU-written) instances
+	VertexArray  m_allVao;
+	VertexArray  m_visibleVao;
+	IndexBuffer  m_indexBuffer;
+	IndirectBuffer m_command;     // one command: 6 indices x visible instances
+
+	AssetRef<Shader> m_cull;
+	AssetRef<Shader> m_shader;
+
+	Mode m_mode = Mode::cpu;
+	unsigned int m_visibleCount = 0; // exact on the CPU paths only (the GPU count stays on the GPU)
+
+public:
+	static bool IsGpuSupported() { return GLEW_VERSION_4_3 || (GLEW_ARB_compute_shader && GLEW_ARB_shader_storage_buffer_object && GLEW_ARB_multi_draw_indirect); }
+
+	SpriteCuller()
+	{
+		const float corners[] = { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f };
+		m_quad = VertexBuffer(corners, sizeof(corners));
+		const GLushort indices[] = { 0, 1, 2, 2, 3, 0 };
+		m_indexBuffer = IndexBuffer(indices, 6);
+
+		m_shader = Assets::LoadShader("res/Shaders/Sprite-Instanced.shader");
+		if (IsGpuSupported())
+		{
+			m_cull = Assets::LoadShader("res/Shaders/Sprite-Cull.shader");
+			m_mode = Mode::gpu;
+		}
+	}
+
+	// Edit, then `Upload()`
+	std::vector<Sprite> &GetSprites() { return m_sprites; }
+	const std::vector<Sprite> &GetSprites() const { return m_sprites; }
+
+	// Mirror the sprite list to the GPU and rebuild the SIMD bounds (world data is expected to change rarely)
+	void Upload()
+	{
+		const size_t count = m_sprites.size();
+		m_minX.resize(count); m_minY.resize(count); m_maxX.resize(count); m_maxY.resize(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			const Sprite &sprite = m_sprites[i];
+			m_minX[i] = sprite.position.x; m_maxX[i] = sprite.position.x + sprite.size.x;
+			m_minY[i] = sprite.position.y; m_maxY[i] = sprite.position.y + sprite.size.y;
+		}
+
+		m_visibleCount = 0;
+		if (count == 0) return;
+
+		const unsigned int size = unsigned(count * sizeof(Sprite));
+		m_allBuffer = VertexBuffer(m_sprites.data(), size);
+		m_visibleBuffer = VertexBuffer::CreateDynamic(size, GL_DYNAMIC_COPY);
+		m_allVao = VertexArray::Create();
+		m_visibleVao = VertexArray::Create();
+		Link(m_allVao, m_allBuffer);
+		Link(m_visibleVao, m_visibleBuffer);
+	}
+
+	void SetMode(Mode mode) { m_mode = mode == Mode::gpu && !IsGpuSupported() ? Mode::cpu : mode; }
+	Mode GetMode() const { return m_mode; }
+
+	// Compacts the sprites overlapping the view rectangle (world units) into the instance buffer
+	void Cull(glm::vec2 viewMin, glm::vec2 viewMax)
+	{
+		const unsigned int count = unsigned(m_sprites.size());
+		if (count == 0) return;
+
+		m_command.Clear();
+		switch (m_mode)
+		{
+		case Mode::none:
+			m_visibleCount = count;
+			m_command.Add(6, 0, 0, count);
+			break;
+
+		case Mode::cpu:
+			CullCpu(viewMin, viewMax);
+			m_command.Add(6, 0, 0, m_visibleCount);
+			break;
+
+		case Mode::gpu:
+		{
+			m_command.Add(6, 0, 0, 0); // the dispatch increments `instanceCount` once per survivor
+			m_command.Upload();
+
+			Shader &cull = *m_cull;
+			cull.Bind();
+			cull.SetUniform1i("u_Count", int(count));
+			cull.SetUniform2f("u_ViewMin", viewMin.x, viewMin.y);
+			cull.SetUniform2f("u_ViewMax", viewMax.x, viewMax.y);
+			GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_allBuffer.GetRendererId()));
+			GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_visibleBuffer.GetRendererId()));
+			GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, m_command.GetRendererId()));
+			GLCall(glDispatchCompute((count + s_groupSize - 1) / s_groupSize, 1, 1));
+			GLCall(glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT));
+			for (unsigned int binding = 0; binding < 3; binding++)
+			{ GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, 0)); }
+			break;
+		}
+		}
+	}
+
+	// One indirect draw of the last `Cull()` result, returns draw API calls
+	unsigned int Draw(const Renderer &renderer, glm::mat4 mvp)
+	{
+		if (m_sprites.empty()) return 0;
+
+		m_shader->Bind();
+		m_shader->SetUniformMat4f("u_MVP", mvp);
+		return renderer.DrawIndirect(m_mode == Mode::none ? m_allVao : m_visibleVao, m_indexBuffer, m_command, *m_shader);
+	}
+
+	unsigned int GetVisibleCount() const { return m_visibleCount; }
+	size_t GetCount() const { return m_sprites.size(); }
+
+private:
+	void Link(VertexArray &vao, const VertexBuffer &instances) const
+	{
+		VertexBufferLayout corner;
+		corner.Push<float>(2); // corner xy
+		vao.AddBuffer(m_quad, corner);
+
+		VertexBufferLayout layout;
+		layout.Push<float>(2); // position xy
+		layout.Push<float>(2); // size xy
+		layout.Push<float>(4); // color rgba
+		layout.SetDivisor(1);
+		vao.AddBuffer(instances, layout, 1);
+	}
+
+	void CullCpu(glm::vec2 viewMin, glm::vec2 viewMax)
+	{
+		m_visible.clear();
+		const size_t count = m_sprites.size();
+		size_t i = 0;
+
+#ifdef SPRITE_CULLER_SSE2
+		const __m128 viewMinX = _mm_set1_ps(viewMin.x), viewMinY = _mm_set1_ps(viewMin.y);
+		const __m128 viewMaxX = _mm_set1_ps(viewMax.x), viewMaxY = _mm_set1_ps(viewMax.y);
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 overlapX = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&m_minX[i]), viewMaxX), _mm_cmpge_ps(_mm_loadu_ps(&m_maxX[i]), viewMinX));
+			const __m128 overlapY = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&m_minY[i]), viewMaxY), _mm_cmpge_ps(_mm_loadu_ps(&m_maxY[i]), viewMinY));
+			int mask = _mm_movemask_ps(_mm_and_ps(overlapX, overlapY));
+			for (size_t lane = i; mask; lane++, mask >>= 1) // most groups are fully culled: `mask == 0` skips them
+				if (mask & 1) m_visible.push_back(m_sprites[lane]);
+		}
+#endif
+		for (; i < count; i++)
+			if (m_minX[i] <= viewMax.x && m_maxX[i] >= viewMin.x && m_minY[i] <= viewMax.y && m_maxY[i] >= viewMin.y)
+				m_visible.push_back(m_sprites[i]);
+
+		m_visibleCount = unsigned(m_visible.size());
+		if (m_visibleCount)
+			m_visibleBuffer.SetData(m_visible.data(), unsigned(m_visible.size() * sizeof(Sprite)));
+	}
+};
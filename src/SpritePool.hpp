@@ -0,0 +1,167 @@
+#pragma once
+
+#include "Utility.hpp"
+#include "AssetCache.hpp"
+#include "Vertex.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cmath>
+#include <vector>
+#include <cstdint>
+
+// Structure-of-arrays sprite storage: each attribute is its own contiguous array, so bulk kernels stream only the
+// fields they touch (the integrator never loads colours), and the batcher walks every array front to back
+// sprites are dense (swap-remove on deletion), generational handles stay valid across removals of other sprites
+class SpritePool
+{
+public:
+	using SpriteHandle = Handle<SpritePool>;
+
+	struct Desc
+	{
+		glm::vec2 position = glm::vec2(0.0f);
+		glm::vec2 velocity = glm::vec2(0.0f); // world units per second
+		float rotation = 0.0f;                // radians
+		float spin = 0.0f;                    // radians per second
+		float scale = 1.0f;
+		glm::vec4 color = glm::vec4(1.0f);
+		float layer = 0.0f;                   // texture slot, `Vertex::texId`
+	};
+
+private:
+	// hot: touched every frame by the kernels
+	std::vector<float> m_x, m_y;
+	std::vector<float> m_velocityX, m_velocityY;
+	std::vector<float> m_rotation, m_spin;
+	std::vector<float> m_scale;
+	// cold: only read by the batcher
+	std::vector<glm::vec4> m_color;
+	std::vector<float> m_layer;
+
+	std::vector<std::uint32_t> m_owners;      // dense index -> handle index
+	std::vector<std::uint32_t> m_dense;       // handle index -> dense index
+	std::vector<std::uint32_t> m_generations; // handle index -> generation (starts at 1, bumped on removal, never 0)
+	std::vector<std::uint32_t> m_freeHandles;
+
+public:
+	SpriteHandle Add(const Desc &desc)
+	{
+		std::uint32_t index;
+		if (!m_freeHandles.empty()) { index = m_freeHandles.back(); m_freeHandles.pop_back(); }
+		else { index = std::uint32_t(m_dense.size()); m_dense.push_back(0); m_generations.push_back(1); }
+
+		m_dense[index] = std::uint32_t(m_x.size());
+		m_owners.push_back(index);
+		m_x.push_back(desc.position.x); m_y.push_back(desc.position.y);
+		m_velocityX.push_back(desc.velocity.x); m_velocityY.push_back(desc.velocity.y);
+		m_rotation.push_back(desc.rotation); m_spin.push_back(desc.spin);
+		m_scale.push_back(desc.scale);
+		m_color.push_back(desc.color);
+		m_layer.push_back(desc.layer);
+		return { index, m_generations[index] };
+	}
+
+	// Swap-remove: the last sprite moves into the hole, its handle is re-pointed
+	void Remove(SpriteHandle handle)
+	{
+		if (!IsValid(handle)) return;
+
+		const std::uint32_t slot = m_dense[handle.index];
+		const std::uint32_t last = std::uint32_t(m_x.size() - 1);
+		if (slot != last)
+		{
+			m_x[slot] = m_x[last]; m_y[slot] = m_y[last];
+			m_velocityX[slot] = m_velocityX[last]; m_velocityY[slot] = m_velocityY[last];
+			m_rotation[slot] = m_rotation[last]; m_spin[slot] = m_spin[last];
+			m_scale[slot] = m_scale[last];
+			m_color[slot] = m_color[last];
+			m_layer[slot] = m_layer[last];
+			m_owners[slot] = m_owners[last];
+			m_dense[m_owners[slot]] = slot;
+		}
+		m_x.pop_back(); m_y.pop_back();
+		m_velocityX.pop_back(); m_velocityY.pop_back();
+		m_rotation.pop_back(); m_spin.pop_back();
+		m_scale.pop_back();
+		m_color.pop_back();
+		m_layer.pop_back();
+		m_owners.pop_back();
+
+		if (++m_generations[handle.index] == 0) m_generations[handle.index] = 1; // skip the null generation on wrap-around
+		m_freeHandles.push_back(handle.index);
+	}
+
+	bool IsValid(SpriteHandle handle) const
+	{
+		return handle.IsValid() && handle.index < m_generations.size() && m_generations[handle.index] == handle.generation;
+	}
+
+	// Per-sprite access (slow path: use the kernels for bulk work)
+	std::uint32_t GetIndex(SpriteHandle handle) const { return m_dense[handle.index]; }
+	void SetPosition(SpriteHandle handle, glm::vec2 position) { const std::uint32_t i = GetIndex(handle); m_x[i] = position.x; m_y[i] = position.y; }
+	glm::vec2 GetPosition(SpriteHandle handle) const { const std::uint32_t i = GetIndex(handle); return { m_x[i], m_y[i] }; }
+	void SetColor(SpriteHandle handle, glm::vec4 color) { m_color[GetIndex(handle)] = color; }
+
+	// Kernel: position += velocity * dt, rotation += spin * dt
+	void Integrate(float deltaTime)
+	{
+		const std::size_t count = m_x.size();
+		float *x = m_x.data(), *y = m_y.data(), *rotation = m_rotation.data();
+		const float *velocityX = m_velocityX.data(), *velocityY = m_velocityY.data(), *spin = m_spin.data();
+		for (std::size_t i = 0; i < count; i++) x[i] += velocityX[i] * deltaTime;
+		for (std::size_t i = 0; i < count; i++) y[i] += velocityY[i] * deltaTime;
+		for (std::size_t i = 0; i < count; i++) rotation[i] += spin[i] * deltaTime;
+	}
+
+	// Kernel: reflect velocities of sprites outside `[min, max]`
+	void Bounce(glm::vec2 min, glm::vec2 max)
+	{
+		const std::size_t count = m_x.size();
+		const float *x = m_x.data(), *y = m_y.data();
+		float *velocityX = m_velocityX.data(), *velocityY = m_velocityY.data();
+		for (std::size_t i = 0; i < count; i++)
+			velocityX[i] = (x[i] < min.x && velocityX[i] < 0.0f) || (x[i] > max.x && velocityX[i] > 0.0f) ? -velocityX[i] : velocityX[i];
+		for (std::size_t i = 0; i < count; i++)
+			velocityY[i] = (y[i] < min.y && velocityY[i] < 0.0f) || (y[i] > max.y && velocityY[i] > 0.0f) ? -velocityY[i] : velocityY[i];
+	}
+
+	// Batcher: 4 rotated/scaled corners per sprite (`size` - unscaled edge), written sequentially into `vertices`
+	// (room for `GetCount() * 4`), indices are the usual `0 1 2 2 3 0` per quad
+	void WriteQuads(Vertex *vertices, float size) const
+	{
+		static constexpr float corners[4][2] = { { -0.5f, -0.5f }, { 0.5f, -0.5f }, { 0.5f, 0.5f }, { -0.5f, 0.5f } };
+		static constexpr float texcoords[4][2] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+
+		const std::size_t count = m_x.size();
+		for (std::size_t i = 0; i < count; i++)
+		{
+			const float extent = size * m_scale[i];
+			const float c = std::cos(m_rotation[i]) * extent, s = std::sin(m_rotation[i]) * extent;
+			const glm::vec4 &color = m_color[i];
+			for (int corner = 0; corner < 4; corner++)
+			{
+				Vertex &vertex = vertices[i * 4 + corner];
+				const float cx = corners[corner][0], cy = corners[corner][1];
+				vertex.position = { m_x[i] + cx * c - cy * s, m_y[i] + cx * s + cy * c };
+				vertex.color = { color.x, color.y, color.z, color.w };
+				vertex.texcoord = { texcoords[corner][0], texcoords[corner][1] };
+				vertex.texId = m_layer[i];
+			}
+		}
+	}
+
+	std::size_t GetCount() const { return m_x.size(); }
+	void Reserve(std::size_t count)
+	{
+		for (std::vector<float> *array : { &m_x, &m_y, &m_velocityX, &m_velocityY, &m_rotation, &m_spin, &m_scale, &m_layer })
+			array->reserve(count);
+		m_color.reserve(count);
+		m_owners.reserve(count);
+	}
+	void Clear()
+	{
+		while (!m_owners.empty())
+			Remove({ m_owners.back(), m_generations[m_owners.back()] });
+	}
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Utility.hpp"
+#include "SpatialIndex.hpp"
+#include "SpriteCuller.hpp"
+
+#include <glm/glm.hpp>
+
+#include <limits>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <utility>
+
+// Sprite container with stable ids, dense storage (swap-remove) and a pluggable spatial index kept in sync on every
+// add/move/remove: view queries for culling and point queries for picking cost O(result), not O(scene)
+class SpriteScene
+{
+public:
+	using Id = SpatialIndex::Id;
+	using Sprite = SpriteCuller::Sprite; // same instance layout as `Sprite-Instanced.shader`
+
+	static constexpr Id s_invalid = std::numeric_limits<Id>::max();
+
+private:
+	std::vector<Sprite> m_sprites;       // dense, draw order
+	std::vector<Id> m_ids;               // dense index -> id
+	std::vector<std::uint32_t> m_slots;  // id -> dense index (`s_invalid` - free)
+	std::vector<Id> m_freeIds;
+	std::unique_ptr<SpatialIndex> m_index;
+	mutable std::vector<Id> m_queryIds;
+
+public:
+	SpriteScene(std::unique_ptr<SpatialIndex> index = std::make_unique<SpatialHashGrid>()) : m_index(std::move(index)) {}
+
+	Id Add(const Sprite &sprite)
+	{
+		Id id;
+		if (!m_freeIds.empty()) { id = m_freeIds.back(); m_freeIds.pop_back(); }
+		else { id = Id(m_slots.size()); m_slots.push_back(s_invalid); }
+
+		m_slots[id] = std::uint32_t(m_sprites.size());
+		m_sprites.push_back(sprite);
+		m_ids.push_back(id);
+		m_index->Insert(id, GetBounds(sprite));
+		return id;
+	}
+
+	void Remove(Id id)
+	{
+		ASSERT(IsValid(id));
+		m_index->Remove(id);
+
+		const std::uint32_t slot = m_slots[id];
+		m_sprites[slot] = m_sprites.back(); // swap-remove keeps storage dense
+		m_ids[slot] = m_ids.back();
+		m_slots[m_ids[slot]] = slot;
+		m_sprites.pop_back();
+		m_ids.pop_back();
+
+		m_slots[id] = s_invalid;
+		m_freeIds.push_back(id);
+	}
+
+	// Incremental: the index only re-buckets the sprite when it leaves its cells/node
+	void Move(Id id, glm::vec2 position)
+	{
+		Sprite &sprite = m_sprites[m_slots[id]];
+		sprite.position = position;
+		m_index->Move(id, GetBounds(sprite));
+	}
+
+	// Swaps the acceleration structure, re-inserting every sprite
+	void SetIndex(std::unique_ptr<SpatialIndex> index)
+	{
+		m_index = std::move(index);
+		for (std::size_t i = 0; i < m_sprites.size(); i++)
+			m_index->Insert(m_ids[i], GetBounds(m_sprites[i]));
+	}
+	const SpatialIndex &GetIndex() const { return *m_index; }
+
+	// Appends the ids of sprites overlapping `view`
+	void Query(const Bounds &view, std::vector<Id> &out) const { m_index->Query(view, out); }
+
+	// Appends copies of the sprites overlapping `view` (instance data, ready for upload)
+	void Gather(const Bounds &view, std::vector<Sprite> &out) const
+	{
+		m_queryIds.clear();
+		m_index->Query(view, m_queryIds);
+		for (const Id id : m_queryIds)
+			out.push_back(m_sprites[m_slots[id]]);
+	}
+
+	// Topmost (last drawn) sprite under `point`, `s_invalid` when none
+	Id Pick(glm::vec2 point) const
+	{
+		m_queryIds.clear();
+		m_index->QueryPoint(point, m_queryIds);
+
+		Id picked = s_invalid;
+		for (const Id id : m_queryIds)
+			if (picked == s_invalid || m_slots[id] > m_slots[picked]) picked = id;
+		return picked;
+	}
+
+	bool IsValid(Id id) const { return id < m_slots.size() && m_slots[id] != s_invalid; }
+	const Sprite &Get(Id id) const { return m_sprites[m_slots[id]]; }
+	Sprite &Get(Id id) { return m_sprites[m_slots[id]]; } // changing position/size needs `Move()`/re-add to stay indexed
+
+	const std::vector<Sprite> &GetSprites() const { return m_sprites; }
+	Id GetId(std::size_t index) const { return m_ids[index]; }
+	std::size_t GetCount() const { return m_sprites.size(); }
+
+	static Bounds GetBounds(const Sprite &sprite) { return { sprite.position, sprite.position + sprite.size }; }
+};
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "Utility.hpp"
+#include "Renderer.hpp"
+#include "QuadBatch.hpp"
+#include "Vertex.hpp"
+#include "Font.hpp"
+#include "Assets.hpp"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+// Batched SDF text: strings are shaped once (glyph lookup, kerning, line breaks) and cached by content,
+// every `Add()` only scales/offsets the cached quads into the shared `Vertex` batch, `Flush()` draws all of it at once
+class TextRenderer
+{
+public:
+	static constexpr std::size_t s_maxCachedStrings = 16384; // the cache is dropped as a whole when exceeded
+
+	struct Quad { float x0, y0, x1, y1, u0, v0, u1, v1; };
+	struct ShapedText
+	{
+		std::vector<Quad> quads; // bake pixels, origin at the first baseline
+		float width = 0.0f;      // widest line
+		int lines = 1;
+	};
+
+private:
+	const Font *m_font = nullptr; // not owned, must outlive the renderer
+	unsigned int m_slot = 0;      // texture unit of the atlas, written as `Vertex::texId`
+
+	std::unordered_map<std::string, ShapedText> m_cache;
+	std::size_t m_hits = 0, m_misses = 0;
+
+	std::vector<Vertex> m_vertices;
+	QuadBatch<Vertex> m_batch;
+	AssetRef<Shader> m_shader;
+	float m_softness = 0.7f;
+
+public:
+	TextRenderer(const Font &font, unsigned int slot = 0) : m_font(&font), m_slot(slot)
+	{
+		m_shader = Assets::LoadShader("res/Shaders/Text-SDF.shader");
+	}
+
+	// Cached layout of `text` (`\n` starts a new line), the reference is valid until the next `Shape()`
+	const ShapedText &Shape(const std::string &text)
+	{
+		if (const auto found = m_cache.find(text); found != m_cache.end())
+		{
+			m_hits++;
+			return found->second;
+		}
+		m_misses++;
+		if (m_cache.size() >= s_maxCachedStrings) m_cache.clear();
+
+		ShapedText shaped;
+		shaped.quads.reserve(text.size());
+		float penX = 0.0f, penY = 0.0f;
+		int previous = 0;
+		for (const char character : text)
+		{
+			const int codepoint = static_cast<unsigned char>(character);
+			if (codepoint == '\n')
+			{
+				shaped.width = std::max(shaped.width, penX);
+				penX = 0.0f;
+				penY -= m_font->GetLineHeight();
+				shaped.lines++;
+				previous = 0;
+				continue;
+			}
+
+			if (previous) penX += m_font->GetKerning(previous, codepoint);
+			const Font::Glyph &glyph = m_font->GetGlyph(codepoint);
+			if (glyph.visible)
+				shaped.quads.push_back({ penX + glyph.x0, penY + glyph.y0, penX + glyph.x1, penY + glyph.y1, glyph.u0, glyph.v0, glyph.u1, glyph.v1 });
+			penX += glyph.advance;
+			previous = codepoint;
+		}
+		shaped.width = std::max(shaped.width, penX);
+
+		return m_cache.emplace(text, std::move(shaped)).first->second;
+	}
+
+	// Appends `text` with its first baseline starting at `position`, `size` - em height in world units
+	void Add(const std::string &text, glm::vec2 position, float size, glm::vec4 color = glm::vec4(1.0f))
+	{
+		const ShapedText &shaped = Shape(text);
+		const float scale = size / m_font->GetBakeSize();
+		const float texId = float(m_slot);
+
+		std::size_t vertex = m_vertices.size();
+		m_vertices.resize(vertex + shaped.quads.size() * 4);
+		for (const Quad &quad : shaped.quads)
+		{
+			const float x0 = position.x + quad.x0 * scale, y0 = position.y + quad.y0 * scale;
+			const float x1 = position.x + quad.x1 * scale, y1 = position.y + quad.y1 * scale;
+			m_vertices[vertex++] = { { x0, y0 }, { color.x, color.y, color.z, color.w }, { quad.u0, quad.v0 }, texId };
+			m_vertices[vertex++] = { { x1, y0 }, { color.x, color.y, color.z, color.w }, { quad.u1, quad.v0 }, texId };
+			m_vertices[vertex++] = { { x1, y1 }, { color.x, color.y, color.z, color.w }, { quad.u1, quad.v1 }, texId };
+			m_vertices[vertex++] = { { x0, y1 }, { color.x, color.y, color.z, color.w }, { quad.u0, quad.v1 }, texId };
+		}
+	}
+
+	glm::vec2 Measure(const std::string &text, float size)
+	{
+		const ShapedText &shaped = Shape(text);
+		const float scale = size / m_font->GetBakeSize();
+		return { shaped.width * scale, float(shaped.lines) * m_font->GetLineHeight() * scale };
+	}
+
+	// Uploads the batch and draws every glyph added since the last flush in one call, returns the glyph count
+	std::size_t Flush(const Renderer &renderer, const glm::mat4 &mvp)
+	{
+		const std::size_t quads = m_vertices.size() / 4;
+		if (quads == 0) return 0;
+
+		m_batch.SetData(m_vertices.data(), quads);
+		m_vertices.clear();
+
+		m_font->GetAtlas().Bind(m_slot);
+		m_shader->Bind();
+		m_shader->SetUniformMat4f("u_MVP", mvp);
+		m_shader->SetTextureSlots("u_Textures");
+		m_shader->SetUniform1f("u_Softness", m_softness);
+		renderer.Draw(m_batch.GetVertexArray(), m_batch.GetIndexBuffer(), *m_shader, unsigned(quads * 6));
+		return quads;
+	}
+
+	void SetSoftness(float softness) { m_softness = softness; }
+	float GetSoftness() const { return m_softness; }
+
+	void ClearCache() { m_cache.clear(); }
+	std::size_t GetCachedCount() const { return m_cache.size(); }
+	std::size_t GetHits() const { return m_hits; }
+	std::size_t GetMisses() const { return m_misses; }
+};
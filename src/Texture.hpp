@@ -1,10 +1,16 @@
 #pragma once
 
 #include "Utility.hpp"
+#include "GpuMemory.hpp"
+#include "Resources.hpp"
+#include "TextureFile.hpp"
 
 #include <stb/stb_image.h>
 #include <GL/glew.h>
 
+#include <iostream>
+#include <utility>
+#include <algorithm>
 #include <filesystem>
 
 class Texture
@@ -13,38 +19,210 @@ class Texture
 	std::filesystem::path m_filePath;
 	unsigned char *m_localBuffer = nullptr;
 	int m_width = 0, m_height = 0, m_bpp = 0;
+	size_t m_memorySize = 0; // bytes of GPU storage (all mip levels)
 
 public:
+	Texture() {} // empty, move-assign a real one later
+	// Prefers a precomputed `<name>.ctex` next to `path` (see `tools/TextureConverter.cpp`), falls back to decoding `path`
+	// both are looked up through `Resources` (pack first, loose file second)
 	Texture(const std::filesystem::path &path) : m_filePath(path)
 	{
-		stbi_set_flip_vertically_on_load(true);
-		m_localBuffer = stbi_load(m_filePath.string().c_str(), &m_width, &m_height, &m_bpp, STBI_rgb_alpha);
-
-		GLCall(glGenTextures(1, &m_rendererId));
-		GLCall(glBindTexture(GL_TEXTURE_2D, m_rendererId));
+		if (HasDSA()) { GLCall(glCreateTextures(GL_TEXTURE_2D, 1, &m_rendererId)); }
+		else
+		{
+			GLCall(glGenTextures(1, &m_rendererId));
+			GLCall(glBindTexture(GL_TEXTURE_2D, m_rendererId));
+		}
 
 		// setup deafult texture settings
-		GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
-		GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
-		GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
-		GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+		SetParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		SetParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		SetParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		SetParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		const std::filesystem::path container = std::filesystem::path(m_filePath).replace_extension(".ctex");
+		if (!LoadContainer(container) && m_filePath.extension() != ".ctex")
+			DecodeImage();
+		GpuMemory::Get().Allocate(GpuMemory::Object::texture, m_rendererId, GpuMemory::Category::texture, m_memorySize);
+
+		if (!HasDSA()) { GLCall(glBindTexture(GL_TEXTURE_2D, 0)); }
+	}
+	// Generated pixels (atlases, render-side data): single level, linear filtering, rows tightly packed
+	// `pixels` may be `nullptr`: storage only, filled later through `SetSubImage()` (see `TextureStreamer`)
+	Texture(int width, int height, GLenum internalFormat, GLenum format, const unsigned char *pixels)
+		: m_width(width), m_height(height), m_bpp(format == GL_RED ? 1 : format == GL_RG ? 2 : format == GL_RGB ? 3 : 4)
+	{
+		if (HasDSA()) { GLCall(glCreateTextures(GL_TEXTURE_2D, 1, &m_rendererId)); }
+		else
+		{
+			GLCall(glGenTextures(1, &m_rendererId));
+			GLCall(glBindTexture(GL_TEXTURE_2D, m_rendererId));
+		}
+
+		SetParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		SetParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		SetParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		SetParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		SetParameter(GL_TEXTURE_MAX_LEVEL, 0);
 
-		GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_localBuffer));
-		GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+		GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 1)); // 1-2 byte texel rows may be odd-sized
+		AllocateStorage(1, internalFormat, width, height);
+		if (pixels || !HasDSA()) UploadLevel(0, internalFormat, width, height, format, GL_UNSIGNED_BYTE, pixels); // GL 3.3: allocates
+		GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+		m_memorySize = size_t(width) * height * m_bpp;
+		GpuMemory::Get().Allocate(GpuMemory::Object::texture, m_rendererId, GpuMemory::Category::texture, m_memorySize);
 
-		if (m_localBuffer)
-			stbi_image_free(m_localBuffer);
+		if (!HasDSA()) { GLCall(glBindTexture(GL_TEXTURE_2D, 0)); }
+	}
+	~Texture()
+	{
+		GpuMemory::Get().Free(GpuMemory::Object::texture, m_rendererId);
+		GLCall(glDeleteTextures(1, &m_rendererId)); // deleting `0` is a silent no-op
+	}
+
+	// Move-only: the GL name is owned by exactly one object
+	Texture(const Texture &) = delete;
+	Texture &operator=(const Texture &) = delete;
+	Texture(Texture &&other) noexcept
+		: m_rendererId(std::exchange(other.m_rendererId, 0)), m_filePath(std::move(other.m_filePath)), m_localBuffer(std::exchange(other.m_localBuffer, nullptr)),
+		  m_width(other.m_width), m_height(other.m_height), m_bpp(other.m_bpp), m_memorySize(std::exchange(other.m_memorySize, 0)) {}
+	Texture &operator=(Texture &&other) noexcept
+	{
+		std::swap(m_rendererId, other.m_rendererId);
+		std::swap(m_filePath, other.m_filePath);
+		std::swap(m_localBuffer, other.m_localBuffer);
+		std::swap(m_width, other.m_width);
+		std::swap(m_height, other.m_height);
+		std::swap(m_bpp, other.m_bpp);
+		std::swap(m_memorySize, other.m_memorySize);
+		return *this;
 	}
-	~Texture() { GLCall(glDeleteTextures(1, &m_rendererId)); }
 
 	void Bind(unsigned int slot) const
 	{
+		if (HasDSA()) { GLCall(glBindTextureUnit(slot, m_rendererId)); return; } // no active-unit round trip
+
 		GLCall(glActiveTexture(GL_TEXTURE0 + slot));
 		GLCall(glBindTexture(GL_TEXTURE_2D, m_rendererId));
 		// also there are a term - "Bindless Texture"
 	}
 	void Unbind() const { GLCall(glBindTexture(GL_TEXTURE_2D, 0)); }
 
+	// Overwrite a `width x height` rectangle of level 0 at `x, y` (rows bottom-up, `GL_UNPACK_ALIGNMENT` applies)
+	// with a `GL_PIXEL_UNPACK_BUFFER` bound, `data` is an offset into it and the copy is queued on the GPU
+	// GL 3.3 path: leaves the texture bound to the active unit
+	void SetSubImage(int x, int y, int width, int height, GLenum format, GLenum type, const void *data)
+	{
+		if (HasDSA()) { GLCall(glTextureSubImage2D(m_rendererId, 0, x, y, width, height, format, type, data)); return; }
+
+		GLCall(glBindTexture(GL_TEXTURE_2D, m_rendererId));
+		GLCall(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, format, type, data));
+	}
+
 	int GetWidth() const { return m_width; }
 	int GetHeight() const { return m_height; }
+	size_t GetMemorySize() const { return m_memorySize; }
+
+private:
+	// Slow path: decode + flip on the CPU, mipmaps generated by the driver
+	void DecodeImage()
+	{
+		const Resource image = Resources::Get().Load(m_filePath);
+		if (!image)
+		{
+			std::cerr << "Error: Fail to open texture path: " << m_filePath << std::endl;
+			return;
+		}
+
+		stbi_set_flip_vertically_on_load(true);
+		m_localBuffer = stbi_load_from_memory(image.GetData(), int(image.GetSize()), &m_width, &m_height, &m_bpp, STBI_rgb_alpha);
+		if (!m_localBuffer)
+		{
+			std::cerr << "Error: Fail to load texture: " << m_filePath << ": " << stbi_failure_reason() << std::endl;
+			return;
+		}
+
+		int levels = 1;
+		while ((std::max(m_width, m_height) >> levels) > 0) levels++;
+		AllocateStorage(levels, GL_RGBA8, m_width, m_height);
+		UploadLevel(0, GL_RGBA8, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, m_localBuffer);
+		if (HasDSA()) { GLCall(glGenerateTextureMipmap(m_rendererId)); }
+		else /*    */ { GLCall(glGenerateMipmap(GL_TEXTURE_2D)); }
+		m_memorySize = size_t(m_width) * m_height * 4 * 4 / 3; // + ~1/3 for the mip chain
+
+		stbi_image_free(m_localBuffer);
+		m_localBuffer = nullptr;
+	}
+
+	// Fast path: mapped `.ctex` levels are uploaded as is (no decode, no flip, no mip generation)
+	bool LoadContainer(const std::filesystem::path &path)
+	{
+		const Resource file = Resources::Get().Load(path);
+		if (!file) return false;
+
+		const ctex::Header *header = ctex::Validate(file.GetData(), file.GetSize());
+		if (!header)
+		{ std::cerr << "Warning: invalid texture container: " << path << std::endl; return false; }
+
+		GLenum internalFormat = GL_RGBA8, format = GL_RGBA, type = GL_UNSIGNED_BYTE;
+		switch (header->format)
+		{
+		case ctex::Format::rgba8:  internalFormat = GL_RGBA8;  format = GL_RGBA; type = GL_UNSIGNED_BYTE;          break;
+		case ctex::Format::rgb565: internalFormat = GL_RGB565; format = GL_RGB;  type = GL_UNSIGNED_SHORT_5_6_5;   break;
+		case ctex::Format::rgba4:  internalFormat = GL_RGBA4;  format = GL_RGBA; type = GL_UNSIGNED_SHORT_4_4_4_4; break;
+		case ctex::Format::bc1:    internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; break;
+		case ctex::Format::bc3:    internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+		}
+		if (ctex::IsCompressed(header->format) && !GLEW_EXT_texture_compression_s3tc)
+		{ std::cerr << "Warning: S3TC unsupported, skipping: " << path << std::endl; return false; }
+
+		GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 1)); // 2-byte texel rows may be odd-sized
+		AllocateStorage(GLsizei(header->levels), internalFormat, GLsizei(header->width), GLsizei(header->height));
+		const ctex::Level *levels = ctex::GetLevels(header);
+		for (unsigned int i = 0; i < header->levels; i++)
+		{
+			const ctex::Level &level = levels[i];
+			const unsigned char *data = file.GetData() + level.offset;
+			m_memorySize += size_t(level.size);
+			if (ctex::IsCompressed(header->format))
+				UploadCompressedLevel(GLint(i), internalFormat, GLsizei(level.width), GLsizei(level.height), GLsizei(level.size), data);
+			else
+				UploadLevel(GLint(i), internalFormat, GLsizei(level.width), GLsizei(level.height), format, type, data);
+		}
+		GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+
+		SetParameter(GL_TEXTURE_MAX_LEVEL, GLint(header->levels - 1));
+		if (header->levels == 1)
+			SetParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+
+		m_width  = int(header->width);
+		m_height = int(header->height);
+		m_bpp    = 4;
+		return true;
+	}
+
+	// GL 4.5 DSA edits the texture by name with immutable storage, GL 3.3 edits the texture bound to `GL_TEXTURE_2D`
+	void SetParameter(GLenum name, GLint value)
+	{
+		if (HasDSA()) { GLCall(glTextureParameteri(m_rendererId, name, value)); }
+		else /*    */ { GLCall(glTexParameteri(GL_TEXTURE_2D, name, value)); }
+	}
+
+	// DSA only: all levels up front, the bind path allocates each level on upload
+	void AllocateStorage(GLsizei levels, GLenum internalFormat, GLsizei width, GLsizei height)
+	{
+		if (HasDSA()) { GLCall(glTextureStorage2D(m_rendererId, levels, internalFormat, width, height)); }
+	}
+
+	void UploadLevel(GLint level, GLenum internalFormat, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *data)
+	{
+		if (HasDSA()) { GLCall(glTextureSubImage2D(m_rendererId, level, 0, 0, width, height, format, type, data)); }
+		else /*    */ { GLCall(glTexImage2D(GL_TEXTURE_2D, level, GLint(internalFormat), width, height, 0, format, type, data)); }
+	}
+
+	void UploadCompressedLevel(GLint level, GLenum internalFormat, GLsizei width, GLsizei height, GLsizei size, const void *data)
+	{
+		if (HasDSA()) { GLCall(glCompressedTextureSubImage2D(m_rendererId, level, 0, 0, width, height, internalFormat, size, data)); }
+		else /*    */ { GLCall(glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, size, data)); }
+	}
 };
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+// `.ctex` - precomputed texture container written by `tools/TextureConverter.cpp`
+// layout: [Header][Level x levels][level data...], little-endian, level data 16-byte aligned
+// pixels are stored bottom-up (pre-flipped for OpenGL) with the full mip chain, so loading is a straight upload
+namespace ctex
+{
+
+enum class Format : std::uint32_t
+{
+	rgba8  = 0, // GL_RGBA8
+	rgb565 = 1, // GL_RGB565  (opaque, 2 bytes/texel)
+	rgba4  = 2, // GL_RGBA4   (2 bytes/texel)
+	bc1    = 3, // S3TC DXT1  (1-bit alpha, 0.5 byte/texel)
+	bc3    = 4, // S3TC DXT5  (8-bit alpha, 1 byte/texel)
+};
+
+enum Flags : std::uint32_t
+{
+	flag_flipped = 1u << 0, // rows are bottom-up
+};
+
+constexpr char          magic[4] = { 'C', 'T', 'E', 'X' };
+constexpr std::uint32_t version  = 1;
+constexpr std::size_t   alignment = 16;
+
+struct Header
+{
+	char          magic[4];
+	std::uint32_t version;
+	Format        format;
+	std::uint32_t width;
+	std::uint32_t height;
+	std::uint32_t levels;
+	std::uint32_t flags;
+	std::uint32_t reserved;
+};
+
+struct Level
+{
+	std::uint32_t width;
+	std::uint32_t height;
+	std::uint64_t offset; // from the start of the file
+	std::uint64_t size;   // bytes
+};
+
+static_assert(sizeof(Header) == 32 && sizeof(Level) == 24);
+
+inline bool IsCompressed(Format format) { return format == Format::bc1 || format == Format::bc3; }
+inline bool IsKnown(Format format) { return format <= Format::bc3; }
+
+inline std::size_t GetLevelSize(Format format, std::uint32_t width, std::uint32_t height)
+{
+	const std::size_t blocks = std::size_t((width + 3) / 4) * ((height + 3) / 4);
+	switch (format)
+	{
+	case Format::rgba8:  return std::size_t(width) * height * 4;
+	case Format::rgb565: return std::size_t(width) * height * 2;
+	case Format::rgba4:  return std::size_t(width) * height * 2;
+	case Format::bc1:    return blocks * 8;
+	case Format::bc3:    return blocks * 16;
+	}
+	return 0;
+}
+
+// Returns `nullptr` if `data` is not a complete, well-formed container
+// the data is uploaded straight from the mapping, so every level must be a mip of the base image and lie inside the file
+inline const Header *Validate(const void *data, std::size_t size)
+{
+	if (!data || size < sizeof(Header)) return nullptr;
+
+	const auto *header = static_cast<const Header *>(data);
+	if (std::memcmp(header->magic, magic, sizeof(magic)) != 0 || header->version != version) return nullptr;
+	if (!IsKnown(header->format) || header->width == 0 || header->height == 0) return nullptr;
+	if (header->levels == 0 || header->levels > 32 || size < sizeof(Header) + sizeof(Level) * header->levels) return nullptr;
+
+	const auto *levels = reinterpret_cast<const Level *>(header + 1);
+	std::uint32_t width = header->width, height = header->height;
+	for (std::uint32_t i = 0; i < header->levels; i++)
+	{
+		if (levels[i].width != width || levels[i].height != height) return nullptr; // base size, then halved (at least 1)
+		if (levels[i].offset > size || levels[i].size > size - levels[i].offset ||
+			levels[i].size != GetLevelSize(header->format, levels[i].width, levels[i].height))
+			return nullptr;
+		width = width > 1 ? width / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+	}
+
+	return header;
+}
+
+inline const Level *GetLevels(const Header *header) { return reinterpret_cast<const Level *>(header + 1); }
+
+}
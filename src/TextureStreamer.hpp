@@ -0,0 +1,124 @@
+#pragma once
+
+#include "Utility.hpp"
+#include "Texture.hpp"
+#include "GpuMemory.hpp"
+
+#include <GL/glew.h>
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+
+// Asynchronous texture updates: pixels are written into a mapped pixel-unpack buffer and `glTexSubImage2D` sources
+// that buffer, so the call returns once the copy is queued - the driver neither copies client memory nor waits for
+// the texture to go idle. A ring of buffers, each fenced, lets the GPU consume one while the CPU fills the next;
+// if the next buffer is still in flight the update is skipped (`false`) instead of blocking - retry next frame
+// RGBA8 rectangles, rows bottom-up and tightly packed
+class TextureStreamer
+{
+public:
+	static constexpr int s_maxRingSize = 8;
+
+private:
+	struct Slot
+	{
+		unsigned int buffer = 0;
+		GLsync fence = nullptr; // set - the GPU may still read the buffer
+		std::size_t capacity = 0; // bytes
+	};
+
+	std::vector<Slot> m_slots;
+	std::size_t m_head = 0; // next slot to fill, also the oldest in flight
+	std::uint64_t m_uploads = 0, m_bytes = 0, m_busy = 0;
+
+public:
+	TextureStreamer(int ringSize = 3) { SetRingSize(ringSize); }
+	~TextureStreamer() { Release(); }
+
+	TextureStreamer(const TextureStreamer &) = delete;
+	TextureStreamer &operator=(const TextureStreamer &) = delete;
+
+	// Drops the ring (buffers still read by the GPU are deleted once it's done with them) and starts over with `ringSize` slots
+	void SetRingSize(int ringSize)
+	{
+		Release();
+		m_slots.resize(std::size_t(std::clamp(ringSize, 1, s_maxRingSize)));
+		m_head = 0;
+	}
+	int GetRingSize() const { return int(m_slots.size()); }
+
+	// `fill(unsigned char *pixels)` writes `width * height * 4` bytes straight into the mapped buffer (write-only
+	// memory, possibly uncached: write sequentially, never read back); returns `false` if the ring is busy
+	template<class Fill>
+	bool UpdateWith(Texture &texture, int x, int y, int width, int height, Fill &&fill)
+	{
+		Slot &slot = m_slots[m_head];
+		if (slot.fence)
+		{
+			GLenum status = GL_TIMEOUT_EXPIRED;
+			GLCall(status = glClientWaitSync(slot.fence, 0, 0)); // timeout 0: a query, never a wait
+			if (status == GL_TIMEOUT_EXPIRED) { m_busy++; return false; }
+			GLCall(glDeleteSync(slot.fence));
+			slot.fence = nullptr;
+		}
+
+		const std::size_t size = std::size_t(width) * height * 4;
+		if (!slot.buffer) { GLCall(glGenBuffers(1, &slot.buffer)); }
+		GLCall(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer));
+		if (size > slot.capacity)
+		{
+			GLCall(glBufferData(GL_PIXEL_UNPACK_BUFFER, GLsizeiptr(size), nullptr, GL_STREAM_DRAW));
+			GpuMemory::Get().Allocate(GpuMemory::Object::buffer, slot.buffer, GpuMemory::Category::upload, size);
+			slot.capacity = size;
+		}
+
+		// the fence guarantees the GPU is done with this buffer: no implicit sync needed
+		void *pixels = nullptr;
+		GLCall(pixels = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, GLsizeiptr(size), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+		if (!pixels)
+		{
+			std::cerr << "Error: TextureStreamer: can't map " << size << " bytes" << std::endl;
+			GLCall(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+			return false;
+		}
+		fill(static_cast<unsigned char *>(pixels));
+		GLboolean intact = GL_TRUE;
+		GLCall(intact = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+
+		if (intact) texture.SetSubImage(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr); // offset 0 into the buffer
+		GLCall(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0)); // later uploads read client memory again
+		if (!intact) return false; // buffer contents lost (display mode change), nothing was queued
+
+		GLCall(slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+		m_head = (m_head + 1) % m_slots.size();
+		m_uploads++;
+		m_bytes += size;
+		return true;
+	}
+	// Copies tightly packed RGBA8 `pixels` (one `memcpy` into the mapped buffer)
+	bool Update(Texture &texture, int x, int y, int width, int height, const unsigned char *pixels)
+	{
+		return UpdateWith(texture, x, y, width, height, [&](unsigned char *destination) {
+			std::memcpy(destination, pixels, std::size_t(width) * height * 4);
+		});
+	}
+
+	std::uint64_t GetUploads() const { return m_uploads; }
+	std::uint64_t GetBytes() const { return m_bytes; }
+	std::uint64_t GetBusy() const { return m_busy; } // updates skipped: every buffer still in flight
+
+private:
+	void Release()
+	{
+		for (Slot &slot : m_slots)
+		{
+			if (slot.fence) { GLCall(glDeleteSync(slot.fence)); }
+			GpuMemory::Get().Free(GpuMemory::Object::buffer, slot.buffer);
+			GLCall(glDeleteBuffers(1, &slot.buffer)); // deleting `0` is a silent no-op
+			slot = Slot();
+		}
+	}
+};
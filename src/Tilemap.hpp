@@ -0,0 +1,187 @@
+#pragma once
+
+#include "Utility.hpp"
+#include "Renderer.hpp"
+#include "VertexArray.hpp"
+#include "VertexBuffer.hpp"
+#include "IndexBuffer.hpp"
+#include "Shader.hpp"
+#include "Vertex.hpp"
+#include "SpatialIndex.hpp"
+
+#include <glm/glm.hpp>
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+// Tile grid split into `chunkSize x chunkSize` chunks, each a static VBO built the first time it's visible and rebuilt
+// only after an edit inside it; drawing walks just the chunks overlapping the view: cost follows the screen, not the map
+class Tilemap
+{
+public:
+	using Tile = std::uint8_t; // index into the tileset atlas, `s_empty` - no quad
+
+	static constexpr Tile s_empty = 0xFF;
+
+	struct Stats
+	{
+		std::size_t visibleChunks = 0, drawnChunks = 0, builtChunks = 0, rebuilds = 0, quads = 0;
+		std::size_t bytes = 0; // vertex memory of all built chunks
+	};
+
+private:
+	struct ChunkMesh
+	{
+		VertexBuffer vertexBuffer;
+		VertexArray vao; // empty until the chunk is built with tiles
+		unsigned int quadCount = 0;
+	};
+	struct Chunk
+	{
+		std::unique_ptr<ChunkMesh> mesh; // lazily created: unseen chunks cost no GL objects
+		bool dirty = true;
+	};
+
+	int m_width, m_height;  // tiles
+	int m_chunkSize;        // tiles per chunk side
+	int m_chunksX, m_chunksY;
+	float m_tileSize;       // world units
+	int m_atlasColumns;     // tileset layout: `m_atlasColumns x m_atlasColumns` cells
+	float m_texId = 0.0f;   // texture slot of the tileset
+
+	std::vector<Tile> m_tiles; // row-major
+	std::vector<Chunk> m_chunks;
+	IndexBuffer m_indexBuffer; // `CreateQuads()` for a full chunk, shared by all chunks
+	std::vector<Vertex> m_scratch;
+	Stats m_stats;
+
+public:
+	Tilemap(int width, int height, float tileSize = 16.0f, int chunkSize = 32, int atlasColumns = 4)
+		: m_width(width), m_height(height), m_chunkSize(chunkSize),
+		  m_chunksX((width + chunkSize - 1) / chunkSize), m_chunksY((height + chunkSize - 1) / chunkSize),
+		  m_tileSize(tileSize), m_atlasColumns(atlasColumns),
+		  m_tiles(std::size_t(width) * height, s_empty), m_chunks(std::size_t(m_chunksX) * m_chunksY)
+	{
+		m_indexBuffer = IndexBuffer::CreateQuads(unsigned(chunkSize * chunkSize));
+		m_scratch.reserve(std::size_t(chunkSize) * chunkSize * 4);
+	}
+
+	Tile Get(int x, int y) const { return m_tiles[std::size_t(y) * m_width + x]; }
+	void Set(int x, int y, Tile tile)
+	{
+		Tile &current = m_tiles[std::size_t(y) * m_width + x];
+		if (current == tile) return;
+		current = tile;
+		m_chunks[std::size_t(y / m_chunkSize) * m_chunksX + x / m_chunkSize].dirty = true;
+	}
+
+	// Bulk fill through `generator(x, y) -> Tile`, every chunk becomes dirty (rebuilt when next seen)
+	template<class F>
+	void Fill(F &&generator)
+	{
+		for (int y = 0; y < m_height; y++)
+			for (int x = 0; x < m_width; x++)
+				m_tiles[std::size_t(y) * m_width + x] = generator(x, y);
+		for (Chunk &chunk : m_chunks) chunk.dirty = true;
+	}
+
+	// Frees meshes of chunks outside `view` (rebuilt on demand): bounds GPU memory on huge maps, walks every chunk - call occasionally
+	void ReleaseHidden(const Bounds &view)
+	{
+		const glm::ivec2 first = GetChunk(view.min), last = GetChunk(view.max);
+		for (int y = 0; y < m_chunksY; y++)
+			for (int x = 0; x < m_chunksX; x++)
+			{
+				if (x >= first.x && x <= last.x && y >= first.y && y <= last.y) continue;
+				Chunk &chunk = m_chunks[std::size_t(y) * m_chunksX + x];
+				if (chunk.mesh) { m_stats.bytes -= chunk.mesh->vertexBuffer.GetSize(); m_stats.builtChunks--; }
+				chunk.mesh.reset();
+				chunk.dirty = true;
+			}
+	}
+
+	// Draws chunks overlapping `view` (world units), building missing/dirty ones first; `shader` - `Batch-Textures` layout
+	void Draw(const Renderer &renderer, const Shader &shader, const Bounds &view)
+	{
+		m_stats.visibleChunks = m_stats.drawnChunks = m_stats.rebuilds = m_stats.quads = 0;
+		if (!GetBounds().Overlaps(view)) return;
+
+		const glm::ivec2 first = GetChunk(view.min), last = GetChunk(view.max);
+		for (int y = first.y; y <= last.y; y++)
+			for (int x = first.x; x <= last.x; x++)
+			{
+				Chunk &chunk = m_chunks[std::size_t(y) * m_chunksX + x];
+				m_stats.visibleChunks++;
+				if (chunk.dirty) Build(chunk, x, y);
+				if (chunk.mesh->quadCount == 0) continue;
+
+				renderer.Draw(chunk.mesh->vao, m_indexBuffer, shader, chunk.mesh->quadCount * 6);
+				m_stats.drawnChunks++;
+				m_stats.quads += chunk.mesh->quadCount;
+			}
+	}
+
+	void SetTextureSlot(unsigned int slot) { m_texId = float(slot); }
+
+	int GetWidth() const { return m_width; }
+	int GetHeight() const { return m_height; }
+	int GetChunkSize() const { return m_chunkSize; }
+	std::size_t GetChunkCount() const { return m_chunks.size(); }
+	float GetTileSize() const { return m_tileSize; }
+	Bounds GetBounds() const { return { glm::vec2(0.0f), glm::vec2(float(m_width), float(m_height)) * m_tileSize }; }
+	const Stats &GetStats() const { return m_stats; }
+
+private:
+	// Chunk containing `point`, clamped to the map
+	glm::ivec2 GetChunk(glm::vec2 point) const
+	{
+		const float chunkWorld = m_tileSize * float(m_chunkSize);
+		return glm::clamp(glm::ivec2(glm::floor(point / chunkWorld)), glm::ivec2(0), glm::ivec2(m_chunksX - 1, m_chunksY - 1));
+	}
+
+	void Build(Chunk &chunk, int chunkX, int chunkY)
+	{
+		m_scratch.clear();
+		const float cell = 1.0f / float(m_atlasColumns), inset = cell / 64.0f; // keep bilinear taps inside the atlas cell
+		const int x0 = chunkX * m_chunkSize, y0 = chunkY * m_chunkSize;
+		const int x1 = std::min(x0 + m_chunkSize, m_width), y1 = std::min(y0 + m_chunkSize, m_height);
+		for (int y = y0; y < y1; y++)
+			for (int x = x0; x < x1; x++)
+			{
+				const Tile tile = Get(x, y);
+				if (tile == s_empty) continue;
+
+				const float left = float(x) * m_tileSize, bottom = float(y) * m_tileSize;
+				const float right = left + m_tileSize, top = bottom + m_tileSize;
+				const float u0 = float(tile % m_atlasColumns) * cell + inset, v0 = float(tile / m_atlasColumns) * cell + inset;
+				const float u1 = u0 + cell - 2.0f * inset, v1 = v0 + cell - 2.0f * inset;
+				m_scratch.push_back({ { left,  bottom }, { 1.0f, 1.0f, 1.0f, 1.0f }, { u0, v0 }, m_texId });
+				m_scratch.push_back({ { right, bottom }, { 1.0f, 1.0f, 1.0f, 1.0f }, { u1, v0 }, m_texId });
+				m_scratch.push_back({ { right, top    }, { 1.0f, 1.0f, 1.0f, 1.0f }, { u1, v1 }, m_texId });
+				m_scratch.push_back({ { left,  top    }, { 1.0f, 1.0f, 1.0f, 1.0f }, { u0, v1 }, m_texId });
+			}
+
+		if (chunk.mesh) m_stats.bytes -= chunk.mesh->vertexBuffer.GetSize();
+		else { chunk.mesh = std::make_unique<ChunkMesh>(); m_stats.builtChunks++; }
+
+		ChunkMesh &mesh = *chunk.mesh;
+		mesh.quadCount = unsigned(m_scratch.size() / 4);
+		if (mesh.quadCount) // static storage: an edit replaces the whole (small) chunk buffer
+		{
+			mesh.vertexBuffer = VertexBuffer(m_scratch.data(), unsigned(m_scratch.size() * sizeof(Vertex)));
+			mesh.vao = VertexArray::Create();
+			mesh.vao.AddBuffer(mesh.vertexBuffer, Vertex::GetLayout());
+		}
+		else
+		{
+			mesh.vertexBuffer = VertexBuffer();
+			mesh.vao = VertexArray();
+		}
+		m_stats.bytes += mesh.vertexBuffer.GetSize();
+
+		chunk.dirty = false;
+		m_stats.rebuilds++;
+	}
+};
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "Utility.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+// Parent/child transforms with lazy world matrices: setters only record the node as dirty, `Update()` recomputes
+// the world matrices of dirty nodes and their subtrees - nothing else is touched, a static scene costs nothing
+// nodes are indices, parents are created before their children (`parent < child`), nodes are never removed
+class TransformHierarchy
+{
+public:
+	using Node = std::uint32_t;
+	static constexpr Node s_none = ~Node(0);
+
+	struct Local
+	{
+		glm::vec3 position = glm::vec3(0.0f);
+		float rotation = 0.0f; // radians, around z
+		glm::vec3 scale = glm::vec3(1.0f);
+	};
+
+private:
+	std::vector<Local> m_local;
+	std::vector<glm::mat4> m_world;
+	std::vector<Node> m_parent, m_firstChild, m_nextSibling;
+	std::vector<char> m_dirty;
+	std::vector<Node> m_dirtyNodes; // unsorted, may hold descendants of other entries
+	std::vector<Node> m_changed;    // world matrices recomputed by the last `Update()`
+	std::vector<Node> m_stack;
+
+public:
+	Node Create(Node parent = s_none) { return Create(parent, Local()); } // `Local` is incomplete in default arguments
+	Node Create(Node parent, const Local &local)
+	{
+		ASSERT(parent == s_none || parent < m_local.size());
+		const Node node = Node(m_local.size());
+		m_local.push_back(local);
+		m_world.push_back(glm::mat4(1.0f));
+		m_parent.push_back(parent);
+		m_firstChild.push_back(s_none);
+		m_nextSibling.push_back(s_none);
+		m_dirty.push_back(0);
+		if (parent != s_none)
+		{
+			m_nextSibling[node] = m_firstChild[parent];
+			m_firstChild[parent] = node;
+		}
+		MarkDirty(node);
+		return node;
+	}
+
+	void SetLocal(Node node, const Local &local) { m_local[node] = local; MarkDirty(node); }
+	void SetPosition(Node node, const glm::vec3 &position) { m_local[node].position = position; MarkDirty(node); }
+	void SetRotation(Node node, float rotation) { m_local[node].rotation = rotation; MarkDirty(node); }
+	void SetScale(Node node, const glm::vec3 &scale) { m_local[node].scale = scale; MarkDirty(node); }
+
+	const Local &GetLocal(Node node) const { return m_local[node]; }
+	Node GetParent(Node node) const { return m_parent[node]; }
+	// Valid after `Update()`
+	const glm::mat4 &GetWorld(Node node) const { return m_world[node]; }
+
+	// Recomputes dirty subtrees, returns the number of world matrices written (also listed by `GetChanged()`)
+	std::size_t Update()
+	{
+		m_changed.clear();
+		// ascending: an ancestor (lower index) is handled first and clears the flags of its whole subtree
+		std::sort(m_dirtyNodes.begin(), m_dirtyNodes.end());
+		for (const Node root : m_dirtyNodes)
+		{
+			if (!m_dirty[root]) continue; // covered by a dirty ancestor
+
+			m_stack.push_back(root);
+			while (!m_stack.empty()) // depth first, no recursion: chains may be 100k deep
+			{
+				const Node node = m_stack.back();
+				m_stack.pop_back();
+				const Node parent = m_parent[node];
+				m_world[node] = parent == s_none ? GetLocalMatrix(m_local[node]) : m_world[parent] * GetLocalMatrix(m_local[node]);
+				m_dirty[node] = 0;
+				m_changed.push_back(node);
+				for (Node child = m_firstChild[node]; child != s_none; child = m_nextSibling[child])
+					m_stack.push_back(child);
+			}
+		}
+		m_dirtyNodes.clear();
+		return m_changed.size();
+	}
+
+	// Baseline: every world matrix, dirty or not, in index order (parents first)
+	std::size_t UpdateAll()
+	{
+		m_changed.clear();
+		for (Node node = 0; node < m_local.size(); node++)
+		{
+			const Node parent = m_parent[node];
+			m_world[node] = parent == s_none ? GetLocalMatrix(m_local[node]) : m_world[parent] * GetLocalMatrix(m_local[node]);
+			m_dirty[node] = 0;
+			m_changed.push_back(node);
+		}
+		m_dirtyNodes.clear();
+		return m_changed.size();
+	}
+
+	const std::vector<Node> &GetChanged() const { return m_changed; }
+	std::size_t GetCount() const { return m_local.size(); }
+	std::size_t GetDirtyCount() const { return m_dirtyNodes.size(); }
+
+	void Reserve(std::size_t nodes)
+	{
+		m_local.reserve(nodes); m_world.reserve(nodes);
+		m_parent.reserve(nodes); m_firstChild.reserve(nodes); m_nextSibling.reserve(nodes);
+		m_dirty.reserve(nodes);
+	}
+	void Clear()
+	{
+		m_local.clear(); m_world.clear();
+		m_parent.clear(); m_firstChild.clear(); m_nextSibling.clear();
+		m_dirty.clear(); m_dirtyNodes.clear(); m_changed.clear();
+	}
+
+	// translate * rotate(z) * scale, written directly (no `glm::rotate` + 3 matrix products)
+	static glm::mat4 GetLocalMatrix(const Local &local)
+	{
+		const float c = std::cos(local.rotation), s = std::sin(local.rotation);
+		glm::mat4 matrix(1.0f);
+		matrix[0] = glm::vec4(c * local.scale.x, s * local.scale.x, 0.0f, 0.0f);
+		matrix[1] = glm::vec4(-s * local.scale.y, c * local.scale.y, 0.0f, 0.0f);
+		matrix[2] = glm::vec4(0.0f, 0.0f, local.scale.z, 0.0f);
+		matrix[3] = glm::vec4(local.position, 1.0f);
+		return matrix;
+	}
+
+private:
+	void MarkDirty(Node node)
+	{
+		if (m_dirty[node]) return;
+		m_dirty[node] = 1;
+		m_dirtyNodes.push_back(node);
+	}
+};
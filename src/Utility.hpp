@@ -4,6 +4,7 @@
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 #include <type_traits>
 
 // Compiler-friendly debug breakpoints (in source code)
@@ -47,6 +48,29 @@
 		BREAKPOINT();\
 	}
 
+// Direct State Access (GL 4.5 / ARB_direct_state_access): GL objects are edited by name instead of bind-to-edit
+// evaluated once, on first use after `glewInit()`; GL wrappers fall back to the GL 3.3 bind path without it
+inline bool HasDSA()
+{
+	static const bool dsa = GLEW_VERSION_4_5 || GLEW_ARB_direct_state_access;
+	return dsa;
+}
+
+// Sampler units a fragment shader may use (`GL_MAX_TEXTURE_IMAGE_UNITS`, >= 16 on GL 3.3), capped to keep the generated
+// `SAMPLE_TEXTURES` switch (see `Shader`) short
+inline int GetMaxTextureSlots()
+{
+	static const int slots = [] {
+		int units = 16;
+		GLCall(glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &units));
+		return std::min(units, 32);
+	}();
+	return slots;
+}
+
+// Exponential moving average for on-screen timings (0 - no sample yet: start at the first one)
+inline float Smooth(float average, float sample) { return average == 0.0f ? sample : average * 0.9f + sample * 0.1f; }
+
 // Forked and polished gist: https://gist.github.com/Challanger524/cdf90cf11809749363fb638646225773
 static void GLAPIENTRY GlDebugMessage_cb(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei, const GLchar *message, const void *)
 {
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "VertexBufferLayout.hpp"
+
+#include <array>
+
+// Batched sprite vertex, matches the attributes of `Batch-Textures.shader`
+struct Vertex {
+	std::array<float, 2> position{ 0.0f, 0.0f };         // xy
+	std::array<float, 4> color{ 0.0f, 0.0f,0.0f, 0.0f }; // rgba
+	std::array<float, 2> texcoord{ 0.0f, 0.0f };         // xy
+	float texId{ 0.f };                                  // <id>
+
+	static VertexBufferLayout GetLayout()
+	{
+		VertexBufferLayout layout;
+		layout.Push<float>(2); // coord xy
+		layout.Push<float>(4); // color rgba
+		layout.Push<float>(2); // texcoord xy
+		layout.Push<float>(1); // texidx <idx>
+		return layout;
+	}
+};
+
+static_assert(sizeof(Vertex) == 9 * sizeof(float));
+
+// `Vertex` of a flipbook-animated sprite, matches `Batch-Textures.shader` compiled with `FLIPBOOK`: the atlas cell is
+// picked in the vertex shader from `u_Time`, so the buffer is written once (`texcoord` spans the sprite, [0, 1])
+struct AnimatedVertex {
+	std::array<float, 2> position{ 0.0f, 0.0f };
+	std::array<float, 4> color{ 0.0f, 0.0f, 0.0f, 0.0f };
+	std::array<float, 2> texcoord{ 0.0f, 0.0f };
+	float texId{ 0.f };
+	std::array<float, 4> flipbook{ 1.0f, 0.0f, 0.0f, 1.0f }; // frames, frames per second, time offset [s], atlas columns
+
+	static VertexBufferLayout GetLayout()
+	{
+		VertexBufferLayout layout;
+		layout.Push<float>(2); // coord xy
+		layout.Push<float>(4); // color rgba
+		layout.Push<float>(2); // texcoord xy
+		layout.Push<float>(1); // texidx <idx>
+		layout.Push<float>(4); // flipbook
+		return layout;
+	}
+};
+
+static_assert(sizeof(AnimatedVertex) == 13 * sizeof(float));
@@ -7,19 +7,41 @@
 #include <GL/glew.h>
 
 #include <vector>
+#include <utility>
 
 class VertexArray
 {
-	unsigned int m_rendererId;
+	unsigned int m_rendererId = 0;
 
 public:
-	VertexArray() { GLCall(glGenVertexArrays(1, &m_rendererId)); }
-	~VertexArray() { GLCall(glDeleteVertexArrays(1, &m_rendererId)); }
+	VertexArray() {} // empty, move-assign `Create()` later
+	~VertexArray() { GLCall(glDeleteVertexArrays(1, &m_rendererId)); } // deleting `0` is a silent no-op
+
+	// A new GL vertex array object without attributes (enough for passes that generate their vertices)
+	static VertexArray Create()
+	{
+		VertexArray vao;
+		if (HasDSA()) { GLCall(glCreateVertexArrays(1, &vao.m_rendererId)); } // DSA needs a created object, `glGen*` only reserves a name
+		else /*    */ { GLCall(glGenVertexArrays(1, &vao.m_rendererId)); }
+		return vao;
+	}
+
+	// Move-only: the GL name is owned by exactly one object
+	VertexArray(const VertexArray &) = delete;
+	VertexArray &operator=(const VertexArray &) = delete;
+	VertexArray(VertexArray &&other) noexcept : m_rendererId(std::exchange(other.m_rendererId, 0)) {}
+	VertexArray &operator=(VertexArray &&other) noexcept { std::swap(m_rendererId, other.m_rendererId); return *this; }
 
 	void Bind() const { GLCall(glBindVertexArray(m_rendererId)); }
 	void Unbind() const { GLCall(glBindVertexArray(0)); }
 
-	void AddBuffer(const VertexBuffer &vb, const VertexBufferLayout &layout) {
+	// Attributes of `layout` get locations `firstAttribute...`: several buffers (e.g. per-vertex + per-instance) can share one VAO
+	void AddBuffer(const VertexBuffer &vb, const VertexBufferLayout &layout, unsigned int firstAttribute = 0) {
+#ifndef NDEBUG
+		ASSERT(m_rendererId != 0); // `Create()` first
+#endif
+		if (HasDSA()) return AddBufferDSA(vb, layout, firstAttribute);
+
 		Bind();
 		vb.Bind();
 		const std::vector<VertexBufferElement> &elements = layout.GetElements();
@@ -27,10 +49,33 @@ public:
 		for (unsigned int i = 0; i < elements.size(); i++)
 		{
 			const auto &element = elements[i];
-			GLCall(glEnableVertexAttribArray(i));
-			GLCall(glVertexAttribPointer(i, element.count, element.type, element.normalized,
+			const unsigned int index = firstAttribute + i;
+			GLCall(glEnableVertexAttribArray(index));
+			GLCall(glVertexAttribPointer(index, element.count, element.type, element.normalized,
 										 layout.GetStride(), reinterpret_cast<const void *>(offset))); // links `vertex-buffer` to `vao`
+			GLCall(glVertexAttribDivisor(index, layout.GetDivisor()));
 			offset += size_t(element.count) * GetSizeOfType(element.type);
 		}
 	}
+
+private:
+	// Same attribute layout without touching the current VAO/`GL_ARRAY_BUFFER` bindings
+	void AddBufferDSA(const VertexBuffer &vb, const VertexBufferLayout &layout, unsigned int firstAttribute)
+	{
+		const unsigned int binding = firstAttribute; // one binding point per buffer
+		GLCall(glVertexArrayVertexBuffer(m_rendererId, binding, vb.GetRendererId(), 0, GLsizei(layout.GetStride())));
+		GLCall(glVertexArrayBindingDivisor(m_rendererId, binding, layout.GetDivisor()));
+
+		const std::vector<VertexBufferElement> &elements = layout.GetElements();
+		unsigned int offset = 0;
+		for (unsigned int i = 0; i < elements.size(); i++)
+		{
+			const auto &element = elements[i];
+			const unsigned int index = firstAttribute + i;
+			GLCall(glEnableVertexArrayAttrib(m_rendererId, index));
+			GLCall(glVertexArrayAttribFormat(m_rendererId, index, GLint(element.count), element.type, element.normalized, offset));
+			GLCall(glVertexArrayAttribBinding(m_rendererId, index, binding));
+			offset += element.count * GetSizeOfType(element.type);
+		}
+	}
 };
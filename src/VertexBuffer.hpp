@@ -1,22 +1,85 @@
 #pragma once
 
 #include "Utility.hpp"
+#include "GpuMemory.hpp"
 
 #include <GL/glew.h>
 
+#include <utility>
+
 class VertexBuffer
 {
-	unsigned int m_rendererId;
+	unsigned int m_rendererId = 0;
+	unsigned int m_size = 0; // bytes
 
 public:
-	VertexBuffer(const void *data, unsigned int size)
+	VertexBuffer() {} // empty, move-assign a real one later
+	// `usage` is a hint for the GL 3.3 path only (e.g. `GL_DYNAMIC_COPY` for buffers the GPU writes)
+	VertexBuffer(const void *data, unsigned int size, GLenum usage = GL_STATIC_DRAW) : m_size(size)
+	{
+		if (HasDSA())
+		{ // immutable storage: no rebinding, no reallocation checks in the driver (GPU writes are still allowed)
+			GLCall(glCreateBuffers(1, &m_rendererId));
+			GLCall(glNamedBufferStorage(m_rendererId, size, data, 0));
+		}
+		else
+		{
+			GLCall(glGenBuffers(1, &m_rendererId));
+			GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_rendererId));
+			GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, usage));
+		}
+		GpuMemory::Get().Allocate(GpuMemory::Object::buffer, m_rendererId, GpuMemory::Category::vertex, size);
+	}
+	~VertexBuffer()
+	{
+		GpuMemory::Get().Free(GpuMemory::Object::buffer, m_rendererId);
+		GLCall(glDeleteBuffers(1, &m_rendererId)); // deleting `0` is a silent no-op
+	}
+
+	// Move-only: the GL name is owned by exactly one object
+	VertexBuffer(const VertexBuffer &) = delete;
+	VertexBuffer &operator=(const VertexBuffer &) = delete;
+	VertexBuffer(VertexBuffer &&other) noexcept : m_rendererId(std::exchange(other.m_rendererId, 0)), m_size(std::exchange(other.m_size, 0)) {}
+	VertexBuffer &operator=(VertexBuffer &&other) noexcept
+	{
+		std::swap(m_rendererId, other.m_rendererId);
+		std::swap(m_size, other.m_size);
+		return *this;
+	}
+
+	// Fixed-size buffer refilled with `SetData()` (the GL name never changes, so VAOs referencing it stay valid)
+	static VertexBuffer CreateDynamic(unsigned int size, GLenum usage = GL_DYNAMIC_DRAW)
 	{
-		GLCall(glGenBuffers(1, &m_rendererId));
-		GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_rendererId));
-		GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+		VertexBuffer buffer;
+		buffer.m_size = size;
+		if (HasDSA())
+		{
+			GLCall(glCreateBuffers(1, &buffer.m_rendererId));
+			GLCall(glNamedBufferStorage(buffer.m_rendererId, size, nullptr, GL_DYNAMIC_STORAGE_BIT));
+		}
+		else
+		{
+			GLCall(glGenBuffers(1, &buffer.m_rendererId));
+			GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, buffer.m_rendererId));
+			GLCall(glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, usage));
+		}
+		GpuMemory::Get().Allocate(GpuMemory::Object::buffer, buffer.m_rendererId, GpuMemory::Category::vertex, size);
+		return buffer;
+	}
+
+	// Overwrite `size` bytes at `offset` (dynamic buffers only with DSA: immutable static storage rejects updates)
+	void SetData(const void *data, unsigned int size, unsigned int offset = 0)
+	{
+		ASSERT(offset + size <= m_size);
+		if (HasDSA()) { GLCall(glNamedBufferSubData(m_rendererId, offset, size, data)); return; }
+
+		GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_rendererId));
+		GLCall(glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data));
 	}
-	~VertexBuffer() { GLCall(glDeleteBuffers(1, &m_rendererId)); }
 
 	void Bind() const { GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_rendererId)); }
 	void Unbind() const { GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0)); }
+
+	unsigned int GetRendererId() const { return m_rendererId; }
+	unsigned int GetSize() const { return m_size; }
 };
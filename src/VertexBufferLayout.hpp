@@ -29,6 +29,7 @@ struct VertexBufferElement
 class VertexBufferLayout
 {
 	unsigned int m_stride = 0;
+	unsigned int m_divisor = 0; // 0 - per vertex, n - advance once per n instances
 	std::vector<VertexBufferElement> m_elements;
 
 public:
@@ -39,6 +40,9 @@ public:
 	const std::vector<VertexBufferElement> &GetElements() const { return m_elements; }
 	unsigned int GetStride() const { return m_stride; }
 
+	void SetDivisor(unsigned int divisor) { m_divisor = divisor; }
+	unsigned int GetDivisor() const { return m_divisor; }
+
 };
 
 template<> inline void VertexBufferLayout::Push<float>(unsigned int count) /*  */ { m_elements.push_back({ GL_FLOAT, count, GL_FALSE }); /*  */ m_stride += GetSizeOfType(GL_FLOAT) * count; }
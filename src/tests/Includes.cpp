@@ -1,11 +1,65 @@
 // Aim of this source file is to test headers for possibility to include them in more than one source file
 
+#if __has_include("AssetCache.hpp")
+#         include "AssetCache.hpp"
+#endif
+#if __has_include("Assets.hpp")
+#         include "Assets.hpp"
+#endif
+#if __has_include("Font.hpp")
+#         include "Font.hpp"
+#endif
+#if __has_include("Camera.hpp")
+#         include "Camera.hpp"
+#endif
+#if __has_include("FrameCapture.hpp")
+#         include "FrameCapture.hpp"
+#endif
+#if __has_include("FrameState.hpp")
+#         include "FrameState.hpp"
+#endif
+#if __has_include("FrameTimer.hpp")
+#         include "FrameTimer.hpp"
+#endif
+#if __has_include("GpuMemory.hpp")
+#         include "GpuMemory.hpp"
+#endif
+#if __has_include("GpuTimer.hpp")
+#         include "GpuTimer.hpp"
+#endif
 #if __has_include("IndexBuffer.hpp")
 #         include "IndexBuffer.hpp"
 #endif
+#if __has_include("IndirectBuffer.hpp")
+#         include "IndirectBuffer.hpp"
+#endif
+#if __has_include("MappedFile.hpp")
+#         include "MappedFile.hpp"
+#endif
+#if __has_include("Mesh.hpp")
+#         include "Mesh.hpp"
+#endif
+#if __has_include("MeshFile.hpp")
+#         include "MeshFile.hpp"
+#endif
+#if __has_include("ParticleSystem.hpp")
+#         include "ParticleSystem.hpp"
+#endif
+#if __has_include("QuadBatch.hpp")
+#         include "QuadBatch.hpp"
+#endif
+#if __has_include("RenderTarget.hpp")
+#         include "RenderTarget.hpp"
+#endif
 #if __has_include("Renderer.hpp")
 #         include "Renderer.hpp"
 #endif
+#if __has_include("Resources.hpp")
+#         include "Resources.hpp"
+#endif
+#if __has_include("ResourcePack.hpp")
+#         include "ResourcePack.hpp"
+#endif
 #if __has_include("Shader.hpp")
 #         include "Shader.hpp"
 #endif
@@ -15,9 +69,45 @@
 #if __has_include("Shader.hpp")
 #         include "Shader.hpp"
 #endif
+#if __has_include("SimulationThread.hpp")
+#         include "SimulationThread.hpp"
+#endif
+#if __has_include("SpatialIndex.hpp")
+#         include "SpatialIndex.hpp"
+#endif
+#if __has_include("SpriteBatch.hpp")
+#         include "SpriteBatch.hpp"
+#endif
+#if __has_include("SpriteCuller.hpp")
+#         include "SpriteCuller.hpp"
+#endif
+#if __has_include("SpritePool.hpp")
+#         include "SpritePool.hpp"
+#endif
+#if __has_include("SpriteScene.hpp")
+#         include "SpriteScene.hpp"
+#endif
+#if __has_include("TextRenderer.hpp")
+#         include "TextRenderer.hpp"
+#endif
+#if __has_include("TextureFile.hpp")
+#         include "TextureFile.hpp"
+#endif
+#if __has_include("TextureStreamer.hpp")
+#         include "TextureStreamer.hpp"
+#endif
+#if __has_include("Tilemap.hpp")
+#         include "Tilemap.hpp"
+#endif
+#if __has_include("Transform.hpp")
+#         include "Transform.hpp"
+#endif
 #if __has_include("Utility.hpp")
 #         include "Utility.hpp"
 #endif
+#if __has_include("Vertex.hpp")
+#         include "Vertex.hpp"
+#endif
 #if __has_include("VertexArray.hpp")
 #         include "VertexArray.hpp"
 #endif
@@ -46,3 +136,61 @@
 #if __has_include("tests/Test-Batching-Textures-dynamic.hpp")
 #         include "tests/Test-Batching-Textures-dynamic.hpp"
 #endif
+#if __has_include("tests/Test-Batching-Indirect.hpp")
+#         include "tests/Test-Batching-Indirect.hpp"
+#endif
+#if __has_include("tests/Test-Particles.hpp")
+#         include "tests/Test-Particles.hpp"
+#endif
+#if __has_include("tests/Test-Sprite-Culling.hpp")
+#         include "tests/Test-Sprite-Culling.hpp"
+#endif
+#if __has_include("tests/Test-Spatial-Index.hpp")
+#         include "tests/Test-Spatial-Index.hpp"
+#endif
+#if __has_include("tests/Test-Sprite-Pool.hpp")
+#         include "tests/Test-Sprite-Pool.hpp"
+#endif
+#if __has_include("tests/Test-Text.hpp")
+#         include "tests/Test-Text.hpp"
+#endif
+#if __has_include("tests/Test-Tilemap.hpp")
+#         include "tests/Test-Tilemap.hpp"
+#endif
+#if __has_include("tests/Test-Render-Targets.hpp")
+#         include "tests/Test-Render-Targets.hpp"
+#endif
+#if __has_include("tests/Test-Sprite-Layers.hpp")
+#         include "tests/Test-Sprite-Layers.hpp"
+#endif
+#if __has_include("tests/Test-Transform-Hierarchy.hpp")
+#         include "tests/Test-Transform-Hierarchy.hpp"
+#endif
+#if __has_include("tests/Test-Mesh.hpp")
+#         include "tests/Test-Mesh.hpp"
+#endif
+#if __has_include("tests/Test-Threaded-Simulation.hpp")
+#         include "tests/Test-Threaded-Simulation.hpp"
+#endif
+#if __has_include("tests/Test-Texture-Streaming.hpp")
+#         include "tests/Test-Texture-Streaming.hpp"
+#endif
+#if __has_include("tests/Test-Flipbook.hpp")
+#         include "tests/Test-Flipbook.hpp"
+#endif
+
+// GL wrappers own their GL name: move-only with non-throwing moves (rebuilt by move-assignment, e.g.
+// `m_vao = VertexArray::Create()`), and a default-constructed one is empty (name 0, deleting it is a no-op)
+#if __has_include("VertexBuffer.hpp") && __has_include("IndexBuffer.hpp") && __has_include("VertexArray.hpp") && __has_include("Shader.hpp") && __has_include("Texture.hpp")
+#include <type_traits>
+template<class T> constexpr bool is_gl_move_only_v = !std::is_copy_constructible_v<T> && !std::is_copy_assignable_v<T> &&
+	std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T> && std::is_default_constructible_v<T>;
+static_assert(is_gl_move_only_v<VertexBuffer>);
+static_assert(is_gl_move_only_v<IndexBuffer>);
+static_assert(is_gl_move_only_v<VertexArray>);
+static_assert(is_gl_move_only_v<Shader>);
+static_assert(is_gl_move_only_v<Texture>);
+#endif
+#if __has_include("RenderTarget.hpp")
+static_assert(is_gl_move_only_v<RenderTarget>);
+#endif
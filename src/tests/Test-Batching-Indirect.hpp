@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Test.hpp"
+#include "Utility.hpp"
+
+#include "Renderer.hpp"
+#include "VertexBuffer.hpp"
+#include "VertexBufferLayout.hpp"
+#include "IndirectBuffer.hpp"
+#include "Assets.hpp"
+
+#include <GL/glew.h>
+#include <imgui/imgui.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace test
+{
+
+// Thousands of sub-draws (one quad each, selected by `baseVertex`) submitted as a single multi-draw-indirect call
+class BatchingIndirect : public Test
+{
+	VertexArray  m_vao = VertexArray::Create();
+	VertexBuffer m_vertexBuffer;
+	IndexBuffer  m_indexBuffer;
+	IndirectBuffer m_commands;
+	AssetRef<Shader> m_shader;
+
+	glm::mat4 m_proj = glm::ortho(0.0f, 960.0f, 0.0f, 720.0f, -1.0f, 1.0f); // screen scale
+
+	int m_quadCount = 0;
+	int m_targetCount = 4096;
+	int m_stride = 1; // draw every n-th quad - sub-draws don't have to be contiguous
+	unsigned int m_drawCalls = 0;
+
+	Renderer m_renderer;
+
+public:
+	~BatchingIndirect() {}
+	BatchingIndirect()
+	{
+		const GLushort indices[] = { 0, 1, 2, 2, 3, 0 }; // shared by every quad: `baseVertex` selects the quad
+		m_indexBuffer = IndexBuffer(indices, 6);
+
+		m_shader = Assets::LoadShader("res/Shaders/Batch.shader");
+		m_shader->Bind();
+	}
+
+	void OnUpdate([[maybe_unused]] float deltaTime = 0.0f) override {}
+	void OnRender() override
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		if (m_quadCount != m_targetCount)
+			BuildQuads(m_targetCount);
+
+		m_commands.Clear();
+		for (int i = 0; i < m_quadCount; i += m_stride)
+			m_commands.Add(6, 0, i * 4);
+
+		m_shader->Bind();
+		m_shader->SetUniformMat4f("u_MVP", m_proj);
+		m_drawCalls = m_renderer.DrawIndirect(m_vao, m_indexBuffer, m_commands, *m_shader);
+	}
+	void OnImGuiRender() override
+	{
+		ImGui::SliderInt("Quads", &m_targetCount, 1, 65536, "%d", ImGuiSliderFlags_Logarithmic);
+		ImGui::SliderInt("Stride", &m_stride, 1, 16);
+		ImGui::Text("Path: %s", IndirectBuffer::IsSupported() ? "glMultiDrawElementsIndirect" : "glDrawElementsBaseVertex loop (GL < 4.3)");
+		ImGui::Text("Sub-draws: %zu, API draw calls: %u", m_commands.GetCount(), m_drawCalls);
+	}
+
+private:
+	void BuildQuads(int count)
+	{
+		const int columns = int(std::ceil(std::sqrt(count * 960.0f / 720.0f)));
+		const float cell = 960.0f / float(columns), size = cell * 0.8f;
+
+		std::vector<float> vertices; // pos[x,y], color[r,g,b,a], ...
+		vertices.reserve(size_t(count) * 4 * 6);
+		for (int i = 0; i < count; i++)
+		{
+			const float x = float(i % columns) * cell, y = float(i / columns) * cell;
+			const float r = float(i % columns) / float(columns), g = 0.6f, b = float(i / columns) * cell / 720.0f;
+			const float quad[4][2] = { { x, y }, { x + size, y }, { x + size, y + size }, { x, y + size } };
+			for (const auto &corner : quad)
+				vertices.insert(vertices.end(), { corner[0], corner[1], r, g, b, 1.0f });
+		}
+
+		m_vertexBuffer = VertexBuffer(vertices.data(), unsigned(vertices.size() * sizeof(float)));
+		VertexBufferLayout layout;
+		layout.Push<float>(2); // coord xy
+		layout.Push<float>(4); // color rgba
+		m_vao.AddBuffer(m_vertexBuffer, layout);
+
+		m_quadCount = count;
+	}
+};
+
+}
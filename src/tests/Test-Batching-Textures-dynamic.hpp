@@ -6,6 +6,10 @@
 #include "IndexBuffer.hpp"
 #include "Shader.hpp"
 #include "Texture.hpp"
+#include "Assets.hpp"
+#include "Vertex.hpp"
+#include "Camera.hpp"
+#include "GpuMemory.hpp"
 
 #include <GL/glew.h>
 #include <imgui/imgui.h>
@@ -14,43 +18,36 @@
 
 #include <array>
 #include <vector>
-#include <memory>
 #include <algorithm>
 
 namespace test
 {
 
-struct Vertex {
-	std::array<float, 2> position{ 0.0f, 0.0f };         // xy
-	std::array<float, 4> color{ 0.0f, 0.0f,0.0f, 0.0f }; // rgba
-	std::array<float, 2> texcoord{ 0.0f, 0.0f };         // xy
-	float texId{ 0.f };                                  // <id>
-};
-
 class BatchingTexturesDynamic : public Test
 {
 	GLenum m_vertexArray;
-	std::unique_ptr<IndexBuffer> m_indexBuffer;
+	IndexBuffer m_indexBuffer;
 	GLenum m_arrayBuffer;
-	std::unique_ptr<Shader> m_shader;
+	AssetRef<Shader> m_shader;
 
-	glm::mat4 m_proj = glm::ortho(0.0f, 960.0f, 0.0f, 720.0f, -1.0f, 1.0f);	   // screen scale
-	glm::mat4 m_view = glm::translate(glm::mat4(1.0f), glm::vec3(-100, 0, 0)); // camera
+	Camera m_camera = Camera(0.0f, 960.0f, 0.0f, 720.0f); // screen scale, view-projection cached
 	glm::vec3 m_translation = glm::vec3(400, 200, 0);
 
-	Texture m_chernoTex{ "res/textures/ChernoLogo.png" };
-	Texture m_hazelTex{ "res/textures/HazelLogo.png" };
+	AssetRef<Texture> m_chernoTex = Assets::LoadTexture("res/textures/ChernoLogo.png");
+	AssetRef<Texture> m_hazelTex  = Assets::LoadTexture("res/textures/HazelLogo.png");
 
 	float m_quad0Position[2] = { 100.0f, 100.0f };
 	float m_quad1Position[2] = { 300.0f, 100.0f };
 
 public:
 	~BatchingTexturesDynamic() {
+		GpuMemory::Get().Free(GpuMemory::Object::buffer, m_arrayBuffer);
 		GLCall(glDeleteBuffers(1, &m_arrayBuffer));
 		GLCall(glDeleteVertexArrays(1, &m_vertexArray));
 	}
 	BatchingTexturesDynamic()
 	{
+		m_camera.SetPosition(glm::vec2(100.0f, 0.0f));
 		GLCall(glGenVertexArrays(1, &m_vertexArray));
 		GLCall(glBindVertexArray(m_vertexArray));
 
@@ -58,6 +55,7 @@ public:
 		GLCall(glGenBuffers(1, &m_arrayBuffer));
 		GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_arrayBuffer));
 		GLCall(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * magic_count, nullptr, GL_DYNAMIC_DRAW));
+		GpuMemory::Get().Allocate(GpuMemory::Object::buffer, m_arrayBuffer, GpuMemory::Category::vertex, sizeof(Vertex) * magic_count);
 
 		GLCall(glEnableVertexArrayAttrib(m_vertexArray, 0u));
 		GLCall(glVertexAttribPointer(0u, std::tuple_size_v<decltype(Vertex::position)>, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void *>(offsetof(Vertex, position))));
@@ -71,7 +69,9 @@ public:
 		GLCall(glEnableVertexArrayAttrib(m_vertexArray, 3u));
 		GLCall(glVertexAttribPointer(3u, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void *>(offsetof(Vertex, texId))));
 
-		m_shader = std::make_unique<Shader>("res/Shaders/Batch-Textures.shader");
+		m_indexBuffer = IndexBuffer::CreateDynamic(magic_count / 4 * 6); // streamed every frame, see `UpdateBatch()`
+
+		m_shader = Assets::LoadShader("res/Shaders/Batch-Textures.shader");
 		m_shader->Bind();
 	}
 
@@ -87,7 +87,8 @@ public:
 		return { v0, v1, v2, v3 };
 	}
 
-	void OnUpdate([[ maybe_unused ]] float deltaTime = 0.0f) override
+	// Rebuilt right before drawing: `OnUpdate` runs on a fixed step and may be skipped on a frame
+	void UpdateBatch()
 	{
 		auto q0 = CreateQuad(m_quad0Position[0], m_quad0Position[1], 0.f);
 		auto q1 = CreateQuad(m_quad1Position[0], m_quad1Position[1], 1.f);
@@ -111,31 +112,34 @@ public:
 					   std::back_inserter(batched_indices),
 					   [&](const auto &val) { return unsigned(val + q0.size()); });
 
-		m_indexBuffer = std::make_unique<IndexBuffer>(batched_indices.data(), unsigned(batched_indices.size()));
+		m_indexBuffer.SetCompact(batched_indices.data(), unsigned(batched_indices.size()), unsigned(batched_positions.size()));
 
 		GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_arrayBuffer));
 		GLCall(glBufferSubData(GL_ARRAY_BUFFER, 0, batched_positions.size() * sizeof(Vertex), batched_positions.data()));
 	}
+	void OnUpdate([[maybe_unused]] float deltaTime = 0.0f) override {}
 	void OnRender() override
 	{
+		UpdateBatch();
+
 		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
 		GLCall(glClear(GL_COLOR_BUFFER_BIT));
 
 		{
 			glm::mat4 model = glm::translate(glm::mat4(1.0f), m_translation);
-			glm::mat4 mvp = m_proj * m_view * model;
+			glm::mat4 mvp = m_camera.GetViewProjection() * model;
 
 			m_shader->Bind();
 			m_shader->SetUniformMat4f("u_MVP", mvp);
 
-			m_chernoTex.Bind(0); m_hazelTex.Bind(1);
-			m_shader->SetUniformVec1i("u_Textures", std::vector{ 0, 1 });
+			m_chernoTex->Bind(0); m_hazelTex->Bind(1);
+			m_shader->SetTextureSlots("u_Textures");
 
 			GLCall(glBindVertexArray(m_vertexArray));
-			m_indexBuffer->Bind();
+			m_indexBuffer.Bind();
 			m_shader->Bind();
 
-			GLCall(glDrawElements(GL_TRIANGLES, m_indexBuffer->GetCount(), GL_UNSIGNED_INT, nullptr));
+			GLCall(glDrawElements(GL_TRIANGLES, m_indexBuffer.GetCount(), m_indexBuffer.GetType(), nullptr));
 		}
 
 	}
@@ -4,9 +4,11 @@
 #include "Utility.hpp"
 
 #include "Renderer.hpp"
+#include "Camera.hpp"
 #include "VertexBuffer.hpp"
 #include "VertexBufferLayout.hpp"
 #include "Texture.hpp"
+#include "Assets.hpp"
 
 #include <GL/glew.h>
 #include <imgui/imgui.h>
@@ -14,7 +16,6 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <vector>
-#include <memory>
 #include <algorithm>
 
 namespace test
@@ -22,17 +23,16 @@ namespace test
 
 class BatchingTextures : public Test
 {
-	std::unique_ptr<VertexArray > m_vao;
-	std::unique_ptr<IndexBuffer > m_indexBuffer;
-	std::unique_ptr<VertexBuffer> m_vertexBuffer;
-	std::unique_ptr<Shader      > m_shader;
+	VertexArray  m_vao = VertexArray::Create();
+	IndexBuffer  m_indexBuffer;
+	VertexBuffer m_vertexBuffer;
+	AssetRef<Shader> m_shader;
 
-	glm::mat4 m_proj = glm::ortho(0.0f, 960.0f, 0.0f, 720.0f, -1.0f, 1.0f);	   // screen scale
-	glm::mat4 m_view = glm::translate(glm::mat4(1.0f), glm::vec3(-100, 0, 0)); // camera
+	Camera m_camera = Camera(0.0f, 960.0f, 0.0f, 720.0f); // screen scale, view-projection cached
 	glm::vec3 m_translation = glm::vec3(400, 200, 0);
 
-	Texture m_chernoTex{ "res/textures/ChernoLogo.png" };
-	Texture m_hazelTex { "res/textures/HazelLogo.png"  };
+	AssetRef<Texture> m_chernoTex = Assets::LoadTexture("res/textures/ChernoLogo.png");
+	AssetRef<Texture> m_hazelTex  = Assets::LoadTexture("res/textures/HazelLogo.png");
 
 	Renderer m_renderer;
 
@@ -40,6 +40,7 @@ public:
 	~BatchingTextures() {}
 	BatchingTextures()
 	{
+		m_camera.SetPosition(glm::vec2(100.0f, 0.0f));
 		// object 1
 		std::vector<float> positions1 = { // pos[x,y], color[r,g,b,a], texcoord[x,y], texidx[i], ...
 			100.0f, 100.0f, 0.18f, 0.6f, 0.96f, 1.0f, 0.0f, 0.0f, 0.f, // 0
@@ -81,21 +82,20 @@ public:
 					   std::back_inserter(batched_indices),
 					   [&](const auto &val) { return unsigned(val + positions1.size() / vertex_elements_count); });
 
-		m_vao = std::make_unique<VertexArray>();
-
 		static_assert(sizeof(float) == sizeof(decltype(batched_positions)::value_type));
-		m_vertexBuffer = std::make_unique<VertexBuffer>(batched_positions.data(), unsigned(batched_positions.size() * sizeof(decltype(batched_positions)::value_type)));
+		m_vertexBuffer = VertexBuffer(batched_positions.data(), unsigned(batched_positions.size() * sizeof(decltype(batched_positions)::value_type)));
 
 		VertexBufferLayout layout;
 		layout.Push<float>(2); // coord xy
 		layout.Push<float>(4); // color rgba
 		layout.Push<float>(2); // texcoord xy
 		layout.Push<float>(1); // texidx <idx>
-		m_vao->AddBuffer(*m_vertexBuffer, layout);
+		m_vao.AddBuffer(m_vertexBuffer, layout);
 
-		m_indexBuffer = std::make_unique<IndexBuffer>(batched_indices.data(), unsigned(batched_indices.size()));
+		m_indexBuffer = IndexBuffer::CreateCompact(batched_indices.data(), unsigned(batched_indices.size()),
+											   unsigned(batched_positions.size() / vertex_elements_count)); // 16-bit indices
 
-		m_shader = std::make_unique<Shader>("res/Shaders/Batch-Textures.shader");
+		m_shader = Assets::LoadShader("res/Shaders/Batch-Textures.shader");
 		m_shader->Bind();
 	}
 
@@ -107,15 +107,15 @@ public:
 
 		{
 			glm::mat4 model = glm::translate(glm::mat4(1.0f), m_translation);
-			glm::mat4 mvp = m_proj * m_view * model;
+			glm::mat4 mvp = m_camera.GetViewProjection() * model;
 
 			m_shader->Bind();
 			m_shader->SetUniformMat4f("u_MVP", mvp);
 
-			m_chernoTex.Bind(0); m_hazelTex.Bind(1);
-			m_shader->SetUniformVec1i("u_Textures", std::vector{ 0, 1 });
+			m_chernoTex->Bind(0); m_hazelTex->Bind(1);
+			m_shader->SetTextureSlots("u_Textures");
 
-			m_renderer.Draw(*m_vao, *m_indexBuffer, *m_shader);
+			m_renderer.Draw(m_vao, m_indexBuffer, *m_shader);
 		}
 
 	}
@@ -4,15 +4,16 @@
 #include "Utility.hpp"
 
 #include "Renderer.hpp"
+#include "Camera.hpp"
 #include "VertexBuffer.hpp"
 #include "VertexBufferLayout.hpp"
+#include "Assets.hpp"
 
 #include <GL/glew.h>
 #include <imgui/imgui.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
-#include <memory>
 #include <vector>
 #include <algorithm>
 #include <type_traits>
@@ -22,13 +23,12 @@ namespace test
 
 class Batching : public Test
 {
-	std::unique_ptr<VertexArray> m_vao;
-	std::unique_ptr<IndexBuffer> m_indexBuffer;
-	std::unique_ptr<VertexBuffer> m_vertexBuffer;
-	std::unique_ptr<Shader> m_shader;
+	VertexArray  m_vao = VertexArray::Create();
+	IndexBuffer  m_indexBuffer;
+	VertexBuffer m_vertexBuffer;
+	AssetRef<Shader> m_shader;
 
-	glm::mat4 m_proj = glm::ortho(0.0f, 960.0f, 0.0f, 720.0f, -1.0f, 1.0f);	   // screen scale
-	glm::mat4 m_view = glm::translate(glm::mat4(1.0f), glm::vec3(-100, 0, 0)); // camera
+	Camera m_camera = Camera(0.0f, 960.0f, 0.0f, 720.0f); // screen scale, view-projection cached
 	glm::vec3 m_translation = glm::vec3(400, 200, 0);
 
 	Renderer m_renderer;
@@ -37,6 +37,7 @@ public:
 	~Batching() {}
 	Batching()
 	{
+		m_camera.SetPosition(glm::vec2(100.0f, 0.0f));
 		// object 1
 		std::vector<float> positions1 = { // pos[x,y], color[r,g,b,a], ...
 			100.0f, 100.0f, 0.18f, 0.6f, 0.96f, 1.0f, // 0
@@ -75,19 +76,18 @@ public:
 					   std::back_inserter(batched_indices),
 					   [&](const auto &val) { return unsigned(val + positions1.size() / (coord_count + color_count)); });
 
-		m_vao = std::make_unique<VertexArray>();
-
 		static_assert(sizeof(float) == sizeof(decltype(batched_positions)::value_type));
-		m_vertexBuffer = std::make_unique<VertexBuffer>(batched_positions.data(), unsigned(batched_positions.size() * sizeof(decltype(batched_positions)::value_type)));
+		m_vertexBuffer = VertexBuffer(batched_positions.data(), unsigned(batched_positions.size() * sizeof(decltype(batched_positions)::value_type)));
 
 		VertexBufferLayout layout;
 		layout.Push<float>(2); // coord xy
 		layout.Push<float>(4); // color rgb
-		m_vao->AddBuffer(*m_vertexBuffer, layout);
+		m_vao.AddBuffer(m_vertexBuffer, layout);
 
-		m_indexBuffer = std::make_unique<IndexBuffer>(batched_indices.data(), unsigned(batched_indices.size()));
+		m_indexBuffer = IndexBuffer::CreateCompact(batched_indices.data(), unsigned(batched_indices.size()),
+											   unsigned(batched_positions.size() / (coord_count + color_count))); // 16-bit indices
 
-		m_shader = std::make_unique<Shader>("res/Shaders/Batch.shader");
+		m_shader = Assets::LoadShader("res/Shaders/Batch.shader");
 		m_shader->Bind();
 	}
 
@@ -100,12 +100,12 @@ public:
 		{
 
 			glm::mat4 model = glm::translate(glm::mat4(1.0f), m_translation);
-			glm::mat4 mvp = m_proj * m_view * model;
+			glm::mat4 mvp = m_camera.GetViewProjection() * model;
 
 			m_shader->Bind();
 			m_shader->SetUniformMat4f("u_MVP", mvp);
 
-			m_renderer.Draw(*m_vao, *m_indexBuffer, *m_shader);
+			m_renderer.Draw(m_vao, m_indexBuffer, *m_shader);
 		}
 
 	}
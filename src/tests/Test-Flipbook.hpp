@@ -0,0 +1,216 @@
+#pragma once
+
+#include "Test.hpp"
+#include "Utility.hpp"
+
+#include "Renderer.hpp"
+#include "Camera.hpp"
+#include "VertexArray.hpp"
+#include "VertexBuffer.hpp"
+#include "IndexBuffer.hpp"
+#include "Texture.hpp"
+#include "Vertex.hpp"
+#include "GpuTimer.hpp"
+#include "Assets.hpp"
+
+#include <GL/glew.h>
+#include <imgui/imgui.h>
+#include <glm/glm.hpp>
+
+#include <cmath>
+#include <array>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+namespace test
+{
+
+// Flipbook-animated sprites from two generated atlases (32-frame spinner, 8-frame pulse), each sprite with its own
+// frame rate and phase. GPU: static vertices, the `FLIPBOOK` shader variant picks the cell from `u_Time` - nothing is
+// uploaded per frame. CPU baseline: texcoords rewritten and the whole vertex buffer re-uploaded every frame
+class FlipbookAnimation : public Test
+{
+	using clock_t = std::chrono::steady_clock;
+
+	static constexpr double s_loop = 64.0; // [s] every animation repeats within it: `u_Time` wraps without a jump and stays precise
+	static constexpr int s_cell = 64; // atlas cell size [px]
+
+	enum class Mode : int { gpu = 0, cpu = 1 };
+
+	Texture m_spinner, m_pulse;
+	AssetRef<Shader> m_flipbookShader, m_shader;
+
+	std::vector<AnimatedVertex> m_vertices; // also the source of the CPU baseline
+	VertexBuffer m_staticBuffer;
+	VertexArray  m_staticVao;
+	std::vector<Vertex> m_cpuVertices;
+	VertexBuffer m_dynamicBuffer;
+	VertexArray  m_dynamicVao;
+	IndexBuffer  m_indexBuffer;
+
+	Camera m_camera = Camera(0.0f, 960.0f, 0.0f, 720.0f);
+	std::mt19937 m_random{ 11 };
+	clock_t::time_point m_start = clock_t::now();
+
+	int m_spriteCount = 20000;
+	int m_mode = int(Mode::gpu);
+	float m_cpuMilliseconds = 0.0f;
+	std::size_t m_uploadedBytes = 0; // last frame
+	GpuTimer m_timer;
+
+	Renderer m_renderer;
+
+public:
+	~FlipbookAnimation() {}
+	FlipbookAnimation()
+	{
+		m_spinner = CreateAtlas(8, 32, 0);
+		m_pulse = CreateAtlas(4, 8, 1);
+
+		m_flipbookShader = Assets::LoadShader("res/Shaders/Batch-Textures.shader", { { "FLIPBOOK", "1" } });
+		m_shader = Assets::LoadShader("res/Shaders/Batch-Textures.shader");
+
+		Build();
+	}
+
+	void OnRender() override
+	{
+		GLCall(glClearColor(0.05f, 0.05f, 0.08f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		const double time = std::fmod(std::chrono::duration<double>(clock_t::now() - m_start).count(), s_loop);
+		const auto start = clock_t::now();
+		Shader &shader = Mode(m_mode) == Mode::gpu ? *m_flipbookShader : *m_shader;
+		if (Mode(m_mode) == Mode::gpu)
+		{
+			shader.Bind();
+			shader.SetUniform1f("u_Time", float(time));
+			m_uploadedBytes = 0;
+		}
+		else
+		{
+			for (std::size_t i = 0; i < m_vertices.size(); i++)
+			{
+				const AnimatedVertex &source = m_vertices[i];
+				Vertex &vertex = m_cpuVertices[i];
+				vertex.position = source.position;
+				vertex.color = source.color;
+				vertex.texcoord = GetFlipbookTexcoord(source, float(time));
+				vertex.texId = source.texId;
+			}
+			m_uploadedBytes = m_cpuVertices.size() * sizeof(Vertex);
+			m_dynamicBuffer.SetData(m_cpuVertices.data(), unsigned(m_uploadedBytes));
+		}
+		m_cpuMilliseconds = Smooth(m_cpuMilliseconds, std::chrono::duration<float, std::milli>(clock_t::now() - start).count());
+
+		glm::mat4 mvp = m_camera.GetViewProjection();
+		m_spinner.Bind(0); m_pulse.Bind(1);
+		shader.Bind();
+		shader.SetUniformMat4f("u_MVP", mvp);
+		shader.SetTextureSlots("u_Textures");
+
+		m_timer.Begin();
+		m_renderer.Draw(Mode(m_mode) == Mode::gpu ? m_staticVao : m_dynamicVao, m_indexBuffer, shader);
+		m_timer.End();
+	}
+	void OnImGuiRender() override
+	{
+		ImGui::SliderInt("Sprites", &m_spriteCount, 100, 200000, "%d", ImGuiSliderFlags_Logarithmic);
+		if (ImGui::IsItemDeactivatedAfterEdit()) Build();
+		const char *modes[] = { "GPU (u_Time, static vertices)", "CPU (texcoords re-uploaded)" };
+		ImGui::Combo("Animation", &m_mode, modes, IM_ARRAYSIZE(modes));
+
+		ImGui::Text("Vertex upload: %.2f MiB / frame", double(m_uploadedBytes) / (1 << 20));
+		ImGui::Text("CPU %.3f ms, GPU %.3f ms", double(m_cpuMilliseconds), double(m_timer.GetMilliseconds()));
+	}
+
+private:
+	void Build()
+	{
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		const std::size_t sprites = std::size_t(m_spriteCount);
+		m_vertices.resize(sprites * 4);
+		for (std::size_t i = 0; i < sprites; i++)
+		{
+			const bool spinner = unit(m_random) < 0.5f;
+			const float size = 12.0f + 36.0f * unit(m_random);
+			const float x = unit(m_random) * (960.0f - size), y = unit(m_random) * (720.0f - size);
+			const float frames = spinner ? 32.0f : 8.0f;
+			const float cycles = std::max(std::round((8.0f + 24.0f * unit(m_random)) * float(s_loop) / frames), 1.0f); // 8-32 fps, whole cycles per loop
+			const std::array<float, 4> flipbook = { frames, cycles * frames / float(s_loop), 10.0f * unit(m_random), spinner ? 8.0f : 4.0f };
+			const std::array<float, 2> corners[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+			for (int corner = 0; corner < 4; corner++)
+			{
+				AnimatedVertex &vertex = m_vertices[i * 4 + std::size_t(corner)];
+				vertex.position = { x + corners[corner][0] * size, y + corners[corner][1] * size };
+				vertex.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+				vertex.texcoord = corners[corner];
+				vertex.texId = spinner ? 0.0f : 1.0f;
+				vertex.flipbook = flipbook;
+			}
+		}
+
+		m_staticBuffer = VertexBuffer(m_vertices.data(), unsigned(m_vertices.size() * sizeof(AnimatedVertex)));
+		m_staticVao = VertexArray::Create();
+		m_staticVao.AddBuffer(m_staticBuffer, AnimatedVertex::GetLayout());
+
+		m_cpuVertices.resize(m_vertices.size());
+		m_dynamicBuffer = VertexBuffer::CreateDynamic(unsigned(m_cpuVertices.size() * sizeof(Vertex)));
+		m_dynamicVao = VertexArray::Create();
+		m_dynamicVao.AddBuffer(m_dynamicBuffer, Vertex::GetLayout());
+
+		m_indexBuffer = IndexBuffer::CreateQuads(unsigned(sprites));
+	}
+
+	// Same mapping as `Batch-Textures.shader` with `FLIPBOOK`
+	static std::array<float, 2> GetFlipbookTexcoord(const AnimatedVertex &vertex, float time)
+	{
+		const float frames = std::max(vertex.flipbook[0], 1.0f), columns = std::max(vertex.flipbook[3], 1.0f);
+		const float rows = std::ceil(frames / columns);
+		const float frame = std::fmod(std::floor((time + vertex.flipbook[2]) * vertex.flipbook[1]), frames);
+		const float cellX = std::fmod(frame, columns), cellY = rows - 1.0f - std::floor(frame / columns);
+		return { (vertex.texcoord[0] + cellX) / columns, (vertex.texcoord[1] + cellY) / rows };
+	}
+
+	// Row-major atlas of `frames` cells, `columns` per row, top-left first: a spinner with a rotating gap (0)
+	// or a pulsing disc (1); shapes stay clear of the cell borders so linear filtering doesn't bleed neighbours in
+	static Texture CreateAtlas(int columns, int frames, int pattern)
+	{
+		const int rows = (frames + columns - 1) / columns;
+		const int width = columns * s_cell, height = rows * s_cell;
+		std::vector<unsigned char> pixels(std::size_t(width) * height * 4, 0);
+		const float tau = 6.2831853f;
+		for (int frame = 0; frame < frames; frame++)
+		{
+			const int originX = frame % columns * s_cell, originY = (rows - 1 - frame / columns) * s_cell; // rows are bottom-up
+			const float phase = float(frame) / float(frames);
+			for (int y = 0; y < s_cell; y++)
+				for (int x = 0; x < s_cell; x++)
+				{
+					const float dx = (float(x) + 0.5f) / s_cell - 0.5f, dy = (float(y) + 0.5f) / s_cell - 0.5f;
+					const float distance = std::sqrt(dx * dx + dy * dy);
+					bool inside;
+					if (pattern == 0)
+					{
+						const float angle = std::fmod(std::atan2(dy, dx) + tau * (1.0f - phase) + tau, tau); // gap turns clockwise
+						inside = distance > 0.28f && distance < 0.42f && angle > 1.2f;
+					}
+					else
+						inside = distance < 0.15f + 0.25f * (0.5f - 0.5f * std::cos(tau * phase));
+					if (!inside) continue;
+
+					unsigned char *texel = &pixels[(std::size_t(originY + y) * width + std::size_t(originX + x)) * 4];
+					texel[0] = pattern == 0 ? 255 : 80;
+					texel[1] = pattern == 0 ? 160 : 220;
+					texel[2] = pattern == 0 ? 40 : 255;
+					texel[3] = 255;
+				}
+		}
+		return Texture(width, height, GL_RGBA8, GL_RGBA, pixels.data());
+	}
+};
+
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "Test.hpp"
+#include "Utility.hpp"
+
+#include "Renderer.hpp"
+#include "Mesh.hpp"
+#include "GpuTimer.hpp"
+#include "Resources.hpp"
+#include "Assets.hpp"
+
+#include <GL/glew.h>
+#include <imgui/imgui.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+
+namespace test
+{
+
+// High-poly model through the import pipeline: the first run parses the OBJ (generating a torus knot when the file
+// doesn't exist), dedups, reorders and writes `.cmesh`; reloads map the cache. Both generated files are git-ignored and
+// kept out of `res.pack`. Each draw copy re-runs the vertex shader for every vertex that misses the post-transform
+// cache, so GPU time follows the ACMR
+class MeshLoading : public Test
+{
+	static constexpr const char *s_path = "res/models/TorusKnot.obj";
+
+	Mesh m_mesh;
+	AssetRef<Shader> m_shader;
+	GpuTimer m_timer;
+
+	glm::mat4 m_viewProjection = glm::perspective(glm::radians(45.0f), 960.0f / 720.0f, 0.1f, 100.0f)
+		* glm::lookAt(glm::vec3(0.0f, 0.0f, 9.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f)); // static camera
+	float m_angle = 0.0f;
+	int m_copies = 4;
+	bool m_wireframe = false;
+
+	float m_importMilliseconds = 0.0f, m_cacheMilliseconds = 0.0f;
+
+	Renderer m_renderer;
+
+public:
+	~MeshLoading() {}
+	MeshLoading()
+	{
+		m_shader = Assets::LoadShader("res/Shaders/Mesh.shader");
+		if (!Resources::Get().Exists(s_path)) GenerateTorusKnot(s_path, 2048, 64);
+		Load();
+	}
+
+	void OnUpdate(float deltaTime = 0.0f) override { m_angle += deltaTime * 0.4f; }
+	void OnRender() override
+	{
+		GLCall(glClearColor(0.05f, 0.05f, 0.07f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+		if (!m_mesh.IsLoaded()) return;
+
+		glm::mat4 model = glm::rotate(glm::mat4(1.0f), m_angle, glm::vec3(0.3f, 1.0f, 0.1f));
+		glm::mat4 mvp = m_viewProjection * model;
+		m_shader->Bind();
+		m_shader->SetUniformMat4f("u_MVP", mvp);
+		m_shader->SetUniformMat4f("u_Model", model);
+		m_shader->SetUniform4f("u_Color", 0.9f, 0.55f, 0.25f, 1.0f);
+		m_shader->SetUniform3f("u_LightDirection", 0.48f, 0.64f, 0.6f);
+
+		GLCall(glEnable(GL_DEPTH_TEST));
+		if (m_wireframe) { GLCall(glPolygonMode(GL_FRONT_AND_BACK, GL_LINE)); }
+		m_timer.Begin();
+		for (int i = 0; i < m_copies; i++) // later copies fail the depth test: vertex work stays, fragment work doesn't
+			m_renderer.Draw(m_mesh.GetVertexArray(), m_mesh.GetIndexBuffer(), *m_shader);
+		m_timer.End();
+		if (m_wireframe) { GLCall(glPolygonMode(GL_FRONT_AND_BACK, GL_FILL)); }
+		GLCall(glDisable(GL_DEPTH_TEST));
+	}
+	void OnImGuiRender() override
+	{
+		if (ImGui::Button("Reload")) Load();
+		ImGui::SameLine();
+		if (ImGui::Button("Re-import OBJ"))
+		{
+			std::error_code error;
+			std::filesystem::remove(std::filesystem::path(s_path).replace_extension(".cmesh"), error);
+			Load();
+		}
+		ImGui::SliderInt("Draw copies", &m_copies, 1, 32);
+		ImGui::Checkbox("Wireframe", &m_wireframe);
+
+		const Mesh::Stats &stats = m_mesh.GetStats();
+		ImGui::Text("Last load: %s, %.2f ms", stats.fromCache ? "mapped .cmesh" : "OBJ import", double(stats.loadMilliseconds));
+		ImGui::Text("OBJ import %.2f ms, .cmesh %.2f ms", double(m_importMilliseconds), double(m_cacheMilliseconds));
+		ImGui::Text("Triangles: %u, vertices: %u (from %u face corners)", stats.triangles, stats.vertices, stats.corners);
+
+		// per draw copy; indexed counts are FIFO estimates, the hardware cache differs per GPU
+		const double triangles = double(stats.triangles);
+		const double unindexed = double(stats.corners), source = stats.acmrSource * triangles, optimized = stats.acmrOptimized * triangles;
+		ImGui::Text("ACMR: %.3f import order -> %.3f optimized (FIFO %u)", double(stats.acmrSource), double(stats.acmrOptimized), Mesh::s_simulatedCacheSize);
+		ImGui::Text("VS invocations / draw: %.0f non-indexed, %.0f indexed, %.0f optimized", unindexed, source, optimized);
+		ImGui::Text("Saved / draw: %.0f vs non-indexed (%.0f%%), %.0f vs import order (%.0f%%)",
+			unindexed - optimized, unindexed > 0.0 ? 100.0 * (1.0 - optimized / unindexed) : 0.0,
+			source - optimized, source > 0.0 ? 100.0 * (1.0 - optimized / source) : 0.0);
+		ImGui::Text("GPU %.3f ms for %d copies", double(m_timer.GetMilliseconds()), m_copies);
+	}
+
+private:
+	void Load()
+	{
+		m_mesh = Mesh(s_path);
+		const Mesh::Stats &stats = m_mesh.GetStats();
+		(stats.fromCache ? m_cacheMilliseconds : m_importMilliseconds) = stats.loadMilliseconds;
+	}
+
+	// (2,3) torus knot tube as an OBJ of quads with `v/vt/vn` corners, `segments x sides` grid vertices
+	static void GenerateTorusKnot(const std::filesystem::path &path, int segments, int sides)
+	{
+		std::error_code error;
+		std::filesystem::create_directories(path.parent_path(), error);
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file)
+		{ std::cerr << "Error: MeshLoading: can't write " << path << std::endl; return; }
+
+		const float tau = 6.2831853f;
+		const auto curve = [](float t, float out[3]) {
+			const float r = 2.0f + std::cos(3.0f * t);
+			out[0] = r * std::cos(2.0f * t); out[1] = r * std::sin(2.0f * t); out[2] = -std::sin(3.0f * t);
+		};
+		const auto normalize = [](float v[3]) {
+			const float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+			for (int i = 0; i < 3; i++) v[i] /= length;
+		};
+
+		std::string text;
+		char line[128];
+		text += "# (2,3) torus knot, generated by test::MeshLoading\n";
+		for (int s = 0; s < segments; s++)
+		{
+			const float t = tau * float(s) / float(segments), epsilon = 1e-3f;
+			float center[3], ahead[3], behind[3];
+			curve(t, center); curve(t + epsilon, ahead); curve(t - epsilon, behind);
+			// tangent and curvature direction from finite differences, binormal completes the frame
+			float tangent[3] = { ahead[0] - behind[0], ahead[1] - behind[1], ahead[2] - behind[2] };
+			float normal[3] = { ahead[0] + behind[0] - 2.0f * center[0], ahead[1] + behind[1] - 2.0f * center[1], ahead[2] + behind[2] - 2.0f * center[2] };
+			normalize(tangent); normalize(normal);
+			const float binormal[3] = { tangent[1] * normal[2] - tangent[2] * normal[1], tangent[2] * normal[0] - tangent[0] * normal[2], tangent[0] * normal[1] - tangent[1] * normal[0] };
+			for (int k = 0; k < sides; k++)
+			{
+				const float angle = tau * float(k) / float(sides), c = std::cos(angle), sn = std::sin(angle);
+				const float n[3] = { c * normal[0] + sn * binormal[0], c * normal[1] + sn * binormal[1], c * normal[2] + sn * binormal[2] };
+				std::snprintf(line, sizeof(line), "v %.5f %.5f %.5f\nvn %.4f %.4f %.4f\nvt %.5f %.5f\n",
+					center[0] + 0.45f * n[0], center[1] + 0.45f * n[1], center[2] + 0.45f * n[2], n[0], n[1], n[2],
+					float(s) / float(segments), float(k) / float(sides));
+				text += line;
+			}
+		}
+		for (int s = 0; s < segments; s++)
+			for (int k = 0; k < sides; k++)
+			{
+				const int a = s * sides + k + 1, b = (s + 1) % segments * sides + k + 1; // 1-based
+				const int c = (s + 1) % segments * sides + (k + 1) % sides + 1, d = s * sides + (k + 1) % sides + 1;
+				std::snprintf(line, sizeof(line), "f %d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d\n", a, a, a, b, b, b, c, c, c, d, d, d);
+				text += line;
+			}
+		file.write(text.data(), std::streamsize(text.size()));
+		std::cout << "Info: MeshLoading: generated " << path << " (" << segments * sides * 2 << " triangles)" << std::endl;
+	}
+};
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Test.hpp"
+#include "Utility.hpp"
+
+#include "ParticleSystem.hpp"
+#include "GpuTimer.hpp"
+
+#include <GL/glew.h>
+#include <imgui/imgui.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+
+namespace test
+{
+
+// Millions of particles simulated and drawn without touching the CPU: compute shader (GL 4.3) or transform feedback (GL 3.3)
+class Particles : public Test
+{
+	ParticleSystem m_particles;
+	GpuTimer m_timer; // one simulation step
+
+	glm::mat4 m_proj = glm::ortho(0.0f, 960.0f, 0.0f, 720.0f, -1.0f, 1.0f); // screen scale
+
+	int m_targetCount = 1 << 20;
+	bool m_useCompute = ParticleSystem::IsComputeSupported();
+	float m_time = 0.0f;
+	float m_gravity = -200.0f;
+
+public:
+	~Particles() {}
+	Particles() { Rebuild(); }
+
+	void OnUpdate(float deltaTime = 0.0f) override
+	{
+		m_time += deltaTime;
+		const glm::vec2 emitter = glm::vec2(480.0f, 360.0f) + 200.0f * glm::vec2(std::cos(m_time), std::sin(m_time * 2.0f) * 0.5f);
+
+		m_timer.Begin();
+		m_particles.Update(deltaTime, emitter);
+		m_timer.End();
+	}
+	void OnRender() override
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		m_particles.Render(m_proj);
+	}
+	void OnImGuiRender() override
+	{
+		ImGui::SliderInt("Particles", &m_targetCount, 1024, int(ParticleSystem::s_maxCount), "%d", ImGuiSliderFlags_Logarithmic);
+		const bool resize = ImGui::IsItemDeactivatedAfterEdit(); // reallocate once the slider is released, not every drag step
+
+		if (!ParticleSystem::IsComputeSupported()) ImGui::BeginDisabled();
+		const bool toggle = ImGui::Checkbox("Compute shader (GL 4.3)", &m_useCompute);
+		if (!ParticleSystem::IsComputeSupported()) ImGui::EndDisabled();
+		if (resize || toggle) Rebuild();
+
+		if (ImGui::SliderFloat("Gravity", &m_gravity, -1000.0f, 1000.0f))
+			m_particles.SetGravity(glm::vec2(0.0f, m_gravity));
+
+		const float milliseconds = m_timer.GetMilliseconds();
+		ImGui::Text("Path: %s", m_particles.IsCompute() ? "compute shader" : "transform feedback (GL 3.3)");
+		ImGui::Text("Simulation step: %.3f ms GPU", double(milliseconds));
+		ImGui::Text("Simulated: %.0f particles/ms", milliseconds > 0.0f ? double(m_particles.GetCount() / milliseconds) : 0.0);
+	}
+
+private:
+	void Rebuild()
+	{
+		m_particles = ParticleSystem(unsigned(m_targetCount), m_useCompute);
+		m_particles.SetGravity(glm::vec2(0.0f, m_gravity));
+	}
+};
+
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "Test.hpp"
+#include "Utility.hpp"
+
+#include "Renderer.hpp"
+#include "RenderTarget.hpp"
+#include "VertexArray.hpp"
+#include "VertexBuffer.hpp"
+#include "IndexBuffer.hpp"
+#include "Vertex.hpp"
+#include "Assets.hpp"
+
+#include <GL/glew.h>
+#include <imgui/imgui.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+namespace test
+{
+
+// Bloom-style post chain: scene -> downsample pyramid -> separable blur at each level -> composite
+// every offscreen target comes from a `RenderTargetPool`: after the first frame nothing is allocated,
+// blur ping-pong targets are released right after use and alias the next pass of the same size
+class RenderTargets : public Test
+{
+	static constexpr int s_quadCount = 48;
+
+	RenderTargetPool m_pool;
+	VertexArray m_fullscreen = VertexArray::Create(); // empty: full-screen passes generate their vertices
+	AssetRef<Shader> m_blit, m_blur, m_composite;
+
+	AssetRef<Shader> m_sceneShader;
+	VertexBuffer m_vertexBuffer = VertexBuffer::CreateDynamic(unsigned(s_quadCount * 4 * sizeof(Vertex)));
+	VertexArray  m_vao = VertexArray::Create();
+	IndexBuffer  m_indexBuffer = IndexBuffer::CreateQuads(s_quadCount);
+	std::vector<Vertex> m_vertices;
+
+	AssetRef<Texture> m_chernoTex = Assets::LoadTexture("res/textures/ChernoLogo.png");
+	AssetRef<Texture> m_hazelTex  = Assets::LoadTexture("res/textures/HazelLogo.png");
+
+	glm::mat4 m_proj = glm::ortho(0.0f, 960.0f, 0.0f, 720.0f, -1.0f, 1.0f); // screen scale
+
+	int m_levels = 4;
+	int m_blurPasses = 2;
+	float m_intensity = 1.5f;
+	int m_format = 0;
+	bool m_pooled = true;
+	float m_time = 0.0f;
+
+	Renderer m_renderer;
+
+public:
+	~RenderTargets() {}
+	RenderTargets()
+	{
+		m_vao.AddBuffer(m_vertexBuffer, Vertex::GetLayout());
+
+		m_blit = Assets::LoadShader("res/Shaders/Blit.shader");
+		m_blur = Assets::LoadShader("res/Shaders/Blur.shader");
+		m_composite = Assets::LoadShader("res/Shaders/Composite.shader");
+		m_sceneShader = Assets::LoadShader("res/Shaders/Batch-Textures.shader");
+	}
+
+	void OnUpdate(float deltaTime = 0.0f) override { m_time += deltaTime; }
+	void OnRender() override
+	{
+		GLint viewport[4] = {};
+		GLCall(glGetIntegerv(GL_VIEWPORT, viewport));
+		const int width = viewport[2], height = viewport[3];
+		if (width <= 0 || height <= 0) return;
+
+		const GLenum formats[] = { GL_RGBA8, GL_RGBA16F, GL_R11F_G11F_B10F };
+		m_pool.SetEnabled(m_pooled);
+
+		RenderTarget &scene = m_pool.Acquire({ width, height, formats[m_format] });
+		scene.Bind();
+		GLCall(glClearColor(0.02f, 0.02f, 0.05f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+		DrawScene();
+
+		GLCall(glDisable(GL_BLEND)); // passes overwrite
+		const RenderTarget *source = &scene;
+		for (int level = 1; level <= m_levels; level++)
+		{
+			const RenderTargetDesc desc = { std::max(1, width >> level), std::max(1, height >> level), formats[m_format] };
+			RenderTarget &down = m_pool.Acquire(desc);
+			Pass(*m_blit, *source, down);
+			if (source != &scene) m_pool.Release(*source); // previous level consumed
+
+			for (int pass = 0; pass < m_blurPasses; pass++)
+			{
+				RenderTarget &temp = m_pool.Acquire(desc); // same target every pass: lifetimes don't overlap
+				m_blur->Bind();
+				m_blur->SetUniform2f("u_Direction", 1.0f / float(desc.width), 0.0f);
+				Pass(*m_blur, down, temp);
+				m_blur->SetUniform2f("u_Direction", 0.0f, 1.0f / float(desc.height));
+				Pass(*m_blur, temp, down);
+				m_pool.Release(temp);
+			}
+			source = &down;
+		}
+
+		RenderTarget::BindDefault(width, height);
+		scene.BindTexture(0);
+		source->BindTexture(1);
+		m_composite->Bind();
+		m_composite->SetUniform1i("u_Scene", 0);
+		m_composite->SetUniform1i("u_Bloom", 1);
+		m_composite->SetUniform1f("u_Intensity", source == &scene ? 0.0f : m_intensity);
+		m_renderer.DrawFullscreen(m_fullscreen, *m_composite);
+		GLCall(glEnable(GL_BLEND));
+
+		m_pool.EndFrame(); // releases `scene` and the last level
+	}
+	void OnImGuiRender() override
+	{
+		ImGui::SliderInt("Downsample levels", &m_levels, 0, 8);
+		ImGui::SliderInt("Blur passes / level", &m_blurPasses, 0, 4);
+		ImGui::SliderFloat("Intensity", &m_intensity, 0.0f, 4.0f);
+		const char *formats[] = { "RGBA8", "RGBA16F", "R11F_G11F_B10F" };
+		ImGui::Combo("Format", &m_format, formats, IM_ARRAYSIZE(formats));
+		ImGui::Checkbox("Pool (unchecked: allocate every frame)", &m_pooled);
+
+		ImGui::Text("Acquires: %zu, peak held: %zu, created this frame: %zu",
+			m_pool.GetAcquires(), m_pool.GetPeakInUse(), m_pool.GetCreations());
+		ImGui::Text("Pooled targets: %zu, %.2f MiB", m_pool.GetCount(), double(m_pool.GetBytes()) / (1 << 20));
+	}
+
+private:
+	// Fullscreen pass `source` -> `destination` (`shader` reads `u_Texture`, other uniforms set by the caller)
+	void Pass(Shader &shader, const RenderTarget &source, const RenderTarget &destination)
+	{
+		destination.Bind();
+		source.BindTexture(0);
+		shader.Bind();
+		shader.SetUniform1i("u_Texture", 0);
+		m_renderer.DrawFullscreen(m_fullscreen, shader);
+	}
+
+	// Logos orbiting the center: small bright details make the blur visible
+	void DrawScene()
+	{
+		m_vertices.clear();
+		for (int i = 0; i < s_quadCount; i++)
+		{
+			const float ring = float(i % 3), angle = m_time * (0.4f + 0.2f * ring) + float(i) * 6.2831853f / float(s_quadCount) * 3.0f;
+			const float radius = 110.0f + 90.0f * ring, size = 30.0f + 15.0f * ring;
+			const float x = 480.0f + std::cos(angle) * radius - size * 0.5f, y = 360.0f + std::sin(angle) * radius - size * 0.5f;
+			const float texId = float(i % 2);
+			m_vertices.push_back({ { x,        y        }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f }, texId });
+			m_vertices.push_back({ { x + size, y        }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 1.0f, 0.0f }, texId });
+			m_vertices.push_back({ { x + size, y + size }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f }, texId });
+			m_vertices.push_back({ { x,        y + size }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f, 1.0f }, texId });
+		}
+		m_vertexBuffer.SetData(m_vertices.data(), unsigned(m_vertices.size() * sizeof(Vertex)));
+
+		m_chernoTex->Bind(0); m_hazelTex->Bind(1);
+		m_sceneShader->Bind();
+		m_sceneShader->SetUniformMat4f("u_MVP", m_proj);
+		m_sceneShader->SetTextureSlots("u_Textures");
+		m_renderer.Draw(m_vao, m_indexBuffer, *m_sceneShader);
+	}
+};
+
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "Test.hpp"
+#include "Utility.hpp"
+
+#include "Renderer.hpp"
+#include "VertexBufferLayout.hpp"
+#include "QuadBatch.hpp"
+#include "IndirectBuffer.hpp"
+#include "SpriteScene.hpp"
+#include "Assets.hpp"
+
+#include <GL/glew.h>
+#include <imgui/imgui.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace test
+{
+
+// 100k-1M moving sprites kept in a spatial index: per-frame cost of moves, the view query and mouse picking
+class SpatialIndexBenchmark : public Test
+{
+	using clock_t = std::chrono::steady_clock;
+
+	SpriteScene m_scene;
+	std::vector<glm::vec2> m_velocities; // by sprite id
+	std::vector<SpriteScene::Sprite> m_visible;
+
+	QuadBatch<SpriteScene::Sprite> m_batch{ InstanceLayout(), QuadBatch<SpriteScene::Sprite>::Mode::perInstance };
+	IndirectBuffer m_command;
+	AssetRef<Shader> m_shader;
+
+	glm::mat4 m_proj = glm::ortho(0.0f, 960.0f, 0.0f, 720.0f, -1.0f, 1.0f); // screen scale
+	glm::vec2 m_camera = glm::vec2(0.0f);
+
+	int m_spriteCount = 100000;
+	float m_worldSize = 20000.0f;
+	int m_moving = 100; // % of sprites moving every step
+	int m_indexType = 0;
+	float m_cellSize = 64.0f;
+	int m_depth = 8;
+
+	SpriteScene::Id m_picked = SpriteScene::s_invalid;
+	float m_updateMilliseconds = 0.0f, m_queryMilliseconds = 0.0f, m_pickMicroseconds = 0.0f;
+
+	Renderer m_renderer;
+
+public:
+	~SpatialIndexBenchmark() {}
+	SpatialIndexBenchmark()
+	{
+		m_shader = Assets::LoadShader("res/Shaders/Sprite-Instanced.shader");
+
+		m_camera = glm::vec2(m_worldSize * 0.5f);
+		Populate();
+	}
+
+	void OnUpdate(float deltaTime = 0.0f) override
+	{
+		const auto start = clock_t::now();
+		const std::size_t moving = m_scene.GetCount() * std::size_t(m_moving) / 100;
+		for (std::size_t i = 0; i < moving; i++)
+		{
+			const SpriteScene::Id id = m_scene.GetId(i);
+			glm::vec2 position = m_scene.Get(id).position + m_velocities[id] * deltaTime;
+			for (int axis = 0; axis < 2; axis++) // bounce off the world edges
+				if (position[axis] < 0.0f || position[axis] > m_worldSize) m_velocities[id][axis] = -m_velocities[id][axis];
+			m_scene.Move(id, position);
+		}
+		m_updateMilliseconds = Smooth(m_updateMilliseconds, std::chrono::duration<float, std::milli>(clock_t::now() - start).count());
+	}
+	void OnRender() override
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		auto start = clock_t::now();
+		m_visible.clear();
+		m_scene.Gather({ m_camera, m_camera + glm::vec2(960.0f, 720.0f) }, m_visible);
+		m_queryMilliseconds = Smooth(m_queryMilliseconds, std::chrono::duration<float, std::milli>(clock_t::now() - start).count());
+
+		start = clock_t::now();
+		const ImGuiIO &io = ImGui::GetIO();
+		m_picked = SpriteScene::s_invalid;
+		if (!io.WantCaptureMouse && io.DisplaySize.x > 0.0f && io.DisplaySize.y > 0.0f)
+		{
+			const glm::vec2 mouse = glm::vec2(io.MousePos.x / io.DisplaySize.x * 960.0f, (1.0f - io.MousePos.y / io.DisplaySize.y) * 720.0f);
+			m_picked = m_scene.Pick(m_camera + mouse);
+		}
+		m_pickMicroseconds = Smooth(m_pickMicroseconds, std::chrono::duration<float, std::micro>(clock_t::now() - start).count());
+
+		if (m_picked != SpriteScene::s_invalid) // highlight on top
+		{
+			SpriteScene::Sprite highlight = m_scene.Get(m_picked);
+			highlight.position -= glm::vec2(2.0f);
+			highlight.size += glm::vec2(4.0f);
+			highlight.color = glm::vec4(1.0f);
+			m_visible.push_back(highlight);
+		}
+		if (m_visible.empty()) return;
+
+		m_batch.SetData(m_visible.data(), m_visible.size());
+
+		m_command.Clear();
+		m_command.Add(6, 0, 0, unsigned(m_visible.size()));
+		glm::mat4 mvp = m_proj * glm::translate(glm::mat4(1.0f), glm::vec3(-m_camera, 0.0f));
+		m_shader->Bind();
+		m_shader->SetUniformMat4f("u_MVP", mvp);
+		m_renderer.DrawIndirect(m_batch.GetVertexArray(), m_batch.GetIndexBuffer(), m_command, *m_shader);
+	}
+	void OnImGuiRender() override
+	{
+		ImGui::SliderInt("Sprites", &m_spriteCount, 1000, 1000000, "%d", ImGuiSliderFlags_Logarithmic);
+		bool rebuild = ImGui::IsItemDeactivatedAfterEdit();
+		ImGui::SliderFloat("World size", &m_worldSize, 960.0f, 200000.0f, "%.0f", ImGuiSliderFlags_Logarithmic);
+		rebuild |= ImGui::IsItemDeactivatedAfterEdit();
+		ImGui::SliderInt("Moving %", &m_moving, 0, 100);
+		ImGui::SliderFloat2("Camera", &m_camera.x, 0.0f, m_worldSize);
+
+		const char *types[] = { "Spatial hash grid", "Loose quadtree", "Linear (no index)" };
+		bool reindex = ImGui::Combo("Index", &m_indexType, types, IM_ARRAYSIZE(types));
+		if (m_indexType == 0) { ImGui::SliderFloat("Cell size", &m_cellSize, 8.0f, 1024.0f, "%.0f", ImGuiSliderFlags_Logarithmic); reindex |= ImGui::IsItemDeactivatedAfterEdit(); }
+		if (m_indexType == 1) { ImGui::SliderInt("Depth", &m_depth, 1, LooseQuadtree::s_maxDepth, "%d", ImGuiSliderFlags_AlwaysClamp); reindex |= ImGui::IsItemDeactivatedAfterEdit(); }
+
+		if (rebuild) Populate();
+		else if (reindex) m_scene.SetIndex(CreateIndex());
+
+		ImGui::Text("%s: moves %.2f ms, view query %.3f ms (%zu visible), pick %.1f us",
+			m_scene.GetIndex().GetName(), double(m_updateMilliseconds), double(m_queryMilliseconds), m_visible.size(), double(m_pickMicroseconds));
+		if (m_picked != SpriteScene::s_invalid)
+			ImGui::Text("Picked: sprite #%u", m_picked);
+	}
+
+private:
+	std::unique_ptr<SpatialIndex> CreateIndex() const
+	{
+		switch (m_indexType)
+		{
+		case 0:  return std::make_unique<SpatialHashGrid>(m_cellSize);
+		case 1:  return std::make_unique<LooseQuadtree>(Bounds{ glm::vec2(0.0f), glm::vec2(m_worldSize) }, m_depth);
+		default: return std::make_unique<LinearIndex>();
+		}
+	}
+
+	void Populate()
+	{
+		m_scene = SpriteScene(CreateIndex());
+		m_velocities.clear();
+
+		std::mt19937 random(7);
+		std::uniform_real_distribution<float> position(0.0f, m_worldSize), size(8.0f, 24.0f), velocity(-120.0f, 120.0f), channel(0.2f, 1.0f);
+		for (int i = 0; i < m_spriteCount; i++)
+		{
+			const float extent = size(random);
+			m_scene.Add({ { position(random), position(random) }, glm::vec2(extent), { channel(random), channel(random), channel(random), 1.0f } });
+			m_velocities.push_back({ velocity(random), velocity(random) });
+		}
+	}
+
+	// `Sprite-Instanced.shader` instance attributes
+	static VertexBufferLayout InstanceLayout()
+	{
+		VertexBufferLayout layout;
+		layout.Push<float>(2); // position xy
+		layout.Push<float>(2); // size xy
+		layout.Push<float>(4); // color rgba
+		return layout;
+	}
+};
+
+}
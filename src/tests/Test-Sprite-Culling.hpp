@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Test.hpp"
+#include "Utility.hpp"
+
+#include "Renderer.hpp"
+#include "SpriteCuller.hpp"
+#include "GpuTimer.hpp"
+
+#include <GL/glew.h>
+#include <imgui/imgui.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace test
+{
+
+// A scrolling world far larger than the screen: only the sprites inside the 960x720 view should cost anything
+class SpriteCulling : public Test
+{
+	SpriteCuller m_culler;
+	GpuTimer m_timer; // cull + draw
+
+	glm::mat4 m_proj = glm::ortho(0.0f, 960.0f, 0.0f, 720.0f, -1.0f, 1.0f); // screen scale
+	glm::vec2 m_camera = glm::vec2(0.0f);
+	glm::vec2 m_scroll = glm::vec2(300.0f, 120.0f); // world units per second
+
+	int m_spriteCount = 200000;
+	float m_worldSize = 40000.0f;
+	int m_mode = 0;
+	float m_cpuMilliseconds = 0.0f;
+	unsigned int m_drawCalls = 0;
+
+	Renderer m_renderer;
+
+public:
+	~SpriteCulling() {}
+	SpriteCulling()
+	{
+		m_mode = int(m_culler.GetMode());
+		Populate();
+	}
+
+	void OnUpdate(float deltaTime = 0.0f) override
+	{
+		m_camera += m_scroll * deltaTime;
+		for (int axis = 0; axis < 2; axis++) // wrap around the world
+			if (m_camera[axis] < 0.0f || m_camera[axis] > m_worldSize) m_camera[axis] -= std::floor(m_camera[axis] / m_worldSize) * m_worldSize;
+	}
+	void OnRender() override
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		const glm::mat4 mvp = m_proj * glm::translate(glm::mat4(1.0f), glm::vec3(-m_camera, 0.0f));
+
+		m_timer.Begin();
+		const auto start = std::chrono::steady_clock::now();
+		m_culler.Cull(m_camera, m_camera + glm::vec2(960.0f, 720.0f));
+		const float milliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		m_cpuMilliseconds = m_cpuMilliseconds * 0.9f + milliseconds * 0.1f;
+		m_drawCalls = m_culler.Draw(m_renderer, mvp);
+		m_timer.End();
+	}
+	void OnImGuiRender() override
+	{
+		ImGui::SliderInt("Sprites", &m_spriteCount, 1000, 1000000, "%d", ImGuiSliderFlags_Logarithmic);
+		const bool resize = ImGui::IsItemDeactivatedAfterEdit();
+		ImGui::SliderFloat("World size", &m_worldSize, 960.0f, 100000.0f, "%.0f", ImGuiSliderFlags_Logarithmic);
+		if (resize || ImGui::IsItemDeactivatedAfterEdit()) Populate();
+		ImGui::SliderFloat2("Scroll", &m_scroll.x, -2000.0f, 2000.0f);
+
+		const char *modes[] = { "GPU (compute)", "CPU (SSE2)", "Off" };
+		if (ImGui::Combo("Culling", &m_mode, modes, IM_ARRAYSIZE(modes)))
+		{
+			m_culler.SetMode(SpriteCuller::Mode(m_mode));
+			m_mode = int(m_culler.GetMode()); // GPU mode falls back to CPU below GL 4.3
+		}
+
+		ImGui::Text("Cull + draw: %.3f ms GPU, %.3f ms CPU, %u draw call(s)", double(m_timer.GetMilliseconds()), double(m_cpuMilliseconds), m_drawCalls);
+		if (m_culler.GetMode() == SpriteCuller::Mode::gpu)
+			ImGui::Text("Visible: counted on the GPU (no readback)");
+		else
+			ImGui::Text("Visible: %u of %zu", m_culler.GetVisibleCount(), m_culler.GetCount());
+	}
+
+private:
+	void Populate()
+	{
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> position(0.0f, m_worldSize), size(8.0f, 32.0f), channel(0.2f, 1.0f);
+
+		std::vector<SpriteCuller::Sprite> &sprites = m_culler.GetSprites();
+		sprites.resize(size_t(m_spriteCount));
+		for (SpriteCuller::Sprite &sprite : sprites)
+		{
+			sprite.position = { position(random), position(random) };
+			sprite.size = glm::vec2(size(random));
+			sprite.color = { channel(random), channel(random), channel(random), 1.0f };
+		}
+		m_culler.Upload();
+	}
+};
+
+}
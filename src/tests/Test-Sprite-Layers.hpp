@@ -0,0 +1,168 @@
+#pragma once
+
+#include "Test.hpp"
+#include "Utility.hpp"
+
+#include "Renderer.hpp"
+#include "Texture.hpp"
+#include "SpriteBatch.hpp"
+#include "GpuTimer.hpp"
+#include "Assets.hpp"
+
+#include <GL/glew.h>
+#include <imgui/imgui.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace test
+{
+
+// Stacked layers of large sprites, a share of them translucent: compares painter's order (all blended, full overdraw)
+// with the opaque front-to-back / translucent back-to-front split, shaded fragments are counted per pass
+class SpriteLayers : public Test
+{
+	struct Layer
+	{
+		glm::vec2 position, velocity, size;
+		glm::vec4 color;
+		float texId, depth;
+	};
+
+	SpriteBatch m_batch;
+	GpuTimer m_timer;
+	Texture m_bricks, m_tiles; // opaque
+	AssetRef<Texture> m_chernoTex = Assets::LoadTexture("res/textures/ChernoLogo.png"); // alpha-cut
+	AssetRef<Texture> m_hazelTex  = Assets::LoadTexture("res/textures/HazelLogo.png");
+	std::vector<Layer> m_sprites;
+	std::mt19937 m_random{ 3 };
+
+	glm::mat4 m_proj = glm::ortho(0.0f, 960.0f, 0.0f, 720.0f, -1.0f, 1.0f); // screen scale, depth [0, 1) passes unchanged
+
+	int m_spriteCount = 5000;
+	float m_translucentShare = 0.2f;
+	int m_mode = int(SpriteBatch::Mode::split);
+	bool m_overdraw = false;
+	bool m_animate = true;
+
+	Renderer m_renderer;
+
+public:
+	~SpriteLayers() {}
+	SpriteLayers()
+	{
+		m_bricks = CreateTexture(0);
+		m_tiles = CreateTexture(1);
+		m_batch.SetTextureOpaque(0, true);
+		m_batch.SetTextureOpaque(1, true);
+		Populate();
+	}
+
+	void OnUpdate(float deltaTime = 0.0f) override
+	{
+		if (!m_animate) return;
+		for (Layer &sprite : m_sprites)
+		{
+			sprite.position += sprite.velocity * deltaTime;
+			for (int axis = 0; axis < 2; axis++) // bounce inside the view, sprites may stick out by half
+			{
+				const float limit = (axis ? 720.0f : 960.0f) - sprite.size[axis] * 0.5f;
+				if (sprite.position[axis] < -sprite.size[axis] * 0.5f || sprite.position[axis] > limit) sprite.velocity[axis] = -sprite.velocity[axis];
+			}
+		}
+	}
+	void OnRender() override
+	{
+		const float background = m_overdraw ? 0.0f : 0.1f; // overdraw view: black is "never shaded"
+		GLCall(glClearColor(background, background, background, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+
+		m_bricks.Bind(0); m_tiles.Bind(1);
+		m_chernoTex->Bind(2); m_hazelTex->Bind(3);
+
+		m_batch.SetMode(SpriteBatch::Mode(m_mode));
+		m_batch.SetOverdrawView(m_overdraw);
+		m_batch.Reserve(m_sprites.size());
+		for (const Layer &sprite : m_sprites)
+			m_batch.Add({ sprite.position, sprite.size, sprite.color, sprite.texId, sprite.depth });
+
+		m_timer.Begin();
+		m_batch.Flush(m_renderer, m_proj);
+		m_timer.End();
+	}
+	void OnImGuiRender() override
+	{
+		ImGui::SliderInt("Sprites", &m_spriteCount, 100, 100000, "%d", ImGuiSliderFlags_Logarithmic);
+		bool repopulate = ImGui::IsItemDeactivatedAfterEdit();
+		ImGui::SliderFloat("Translucent share", &m_translucentShare, 0.0f, 1.0f);
+		if (repopulate || ImGui::IsItemDeactivatedAfterEdit()) Populate();
+
+		const char *modes[] = { "Blended, back-to-front", "Opaque front-to-back + translucent" };
+		ImGui::Combo("Mode", &m_mode, modes, IM_ARRAYSIZE(modes));
+		ImGui::Checkbox("Overdraw view", &m_overdraw);
+		ImGui::SameLine();
+		ImGui::Checkbox("Animate", &m_animate);
+
+		GLint viewport[4] = {};
+		GLCall(glGetIntegerv(GL_VIEWPORT, viewport));
+		const double pixels = std::max(1.0, double(viewport[2]) * double(viewport[3]));
+		const SpriteBatch::Samples &samples = m_batch.GetSamples();
+		ImGui::Text("Opaque: %zu sprites, %.2f M fragments", m_batch.GetOpaqueCount(), double(samples.opaque) * 1e-6);
+		ImGui::Text("Translucent: %zu sprites, %.2f M fragments", m_batch.GetTranslucentCount(), double(samples.translucent) * 1e-6);
+		ImGui::Text("Shaded per pixel: %.2f, GPU %.3f ms", double(samples.opaque + samples.translucent) / pixels, double(m_timer.GetMilliseconds()));
+	}
+
+private:
+	void Populate()
+	{
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		m_sprites.resize(std::size_t(m_spriteCount));
+		for (std::size_t i = 0; i < m_sprites.size(); i++)
+		{
+			Layer &sprite = m_sprites[i];
+			const float size = 40.0f + 160.0f * unit(m_random);
+			sprite.size = glm::vec2(size, size);
+			sprite.position = glm::vec2(unit(m_random) * (960.0f - size), unit(m_random) * (720.0f - size));
+			sprite.velocity = glm::vec2(unit(m_random) - 0.5f, unit(m_random) - 0.5f) * 120.0f;
+			sprite.depth = unit(m_random) * 0.999f;
+
+			if (unit(m_random) < m_translucentShare)
+			{ // logos with alpha, or a tinted translucent tile
+				const bool logo = unit(m_random) < 0.5f;
+				sprite.texId = logo ? float(2 + i % 2) : float(i % 2);
+				sprite.color = glm::vec4(1.0f, 1.0f, 1.0f, logo ? 1.0f : 0.5f);
+			}
+			else
+			{
+				sprite.texId = float(i % 2);
+				sprite.color = glm::vec4(0.6f + 0.4f * unit(m_random), 0.6f + 0.4f * unit(m_random), 0.6f + 0.4f * unit(m_random), 1.0f);
+			}
+		}
+	}
+
+	// 32x32 opaque patterns: bricks (0) or checker tiles (1)
+	static Texture CreateTexture(int pattern)
+	{
+		constexpr int size = 32;
+		std::vector<unsigned char> pixels(std::size_t(size) * size * 4, 255);
+		for (int y = 0; y < size; y++)
+			for (int x = 0; x < size; x++)
+			{
+				const bool line = pattern == 0
+					? (y % 8 == 0 || (x + (y / 8 % 2) * 8) % 16 == 0)
+					: ((x / 8 + y / 8) % 2 == 0);
+				unsigned char *texel = &pixels[(std::size_t(y) * size + x) * 4];
+				texel[0] = line ? 90 : (pattern == 0 ? 170 : 200);
+				texel[1] = line ? 90 : (pattern == 0 ? 80 : 200);
+				texel[2] = line ? 90 : (pattern == 0 ? 60 : 210);
+			}
+		return Texture(size, size, GL_RGBA8, GL_RGBA, pixels.data());
+	}
+};
+
+}
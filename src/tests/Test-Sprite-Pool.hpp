@@ -0,0 +1,141 @@
+#pragma once
+
+#include "Test.hpp"
+#include "Utility.hpp"
+
+#include "Renderer.hpp"
+#include "QuadBatch.hpp"
+#include "IndirectBuffer.hpp"
+#include "SpritePool.hpp"
+#include "Vertex.hpp"
+#include "Assets.hpp"
+
+#include <GL/glew.h>
+#include <imgui/imgui.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace test
+{
+
+// Hundreds of thousands of spinning sprites in a `SpritePool`: bulk SoA kernels, one sequential pass writing
+// the batch and a single draw of every live quad, with a share of sprites despawned/spawned every step
+class SpritePoolBenchmark : public Test
+{
+	using clock_t = std::chrono::steady_clock;
+
+	SpritePool m_pool;
+	std::vector<SpritePool::SpriteHandle> m_handles;
+	std::vector<Vertex> m_vertices;
+	std::mt19937 m_random{ 7 };
+
+	QuadBatch<Vertex> m_batch;
+	IndirectBuffer m_command;
+	AssetRef<Shader> m_shader;
+
+	AssetRef<Texture> m_chernoTex = Assets::LoadTexture("res/textures/ChernoLogo.png");
+	AssetRef<Texture> m_hazelTex  = Assets::LoadTexture("res/textures/HazelLogo.png");
+
+	glm::mat4 m_proj = glm::ortho(0.0f, 960.0f, 0.0f, 720.0f, -1.0f, 1.0f); // screen scale
+
+	int m_spriteCount = 100000;
+	float m_spriteSize = 12.0f;
+	float m_churn = 1.0f; // % of sprites replaced every step
+
+	float m_kernelMilliseconds = 0.0f, m_churnMilliseconds = 0.0f, m_buildMilliseconds = 0.0f;
+
+	Renderer m_renderer;
+
+public:
+	~SpritePoolBenchmark() {}
+	SpritePoolBenchmark()
+	{
+		m_shader = Assets::LoadShader("res/Shaders/Batch-Textures.shader");
+
+		Populate();
+	}
+
+	void OnUpdate(float deltaTime = 0.0f) override
+	{
+		auto start = clock_t::now();
+		m_pool.Integrate(deltaTime);
+		m_pool.Bounce(glm::vec2(0.0f), glm::vec2(960.0f, 720.0f));
+		m_kernelMilliseconds = Smooth(m_kernelMilliseconds, std::chrono::duration<float, std::milli>(clock_t::now() - start).count());
+
+		start = clock_t::now();
+		const std::size_t churn = std::size_t(float(m_handles.size()) * m_churn / 100.0f);
+		for (std::size_t i = 0; i < churn; i++)
+		{
+			const std::size_t victim = std::uniform_int_distribution<std::size_t>(0, m_handles.size() - 1)(m_random);
+			m_pool.Remove(m_handles[victim]); // swap-remove inside the pool...
+			m_handles[victim] = Spawn();      // ...the freed handle slot is recycled with a new generation
+		}
+		m_churnMilliseconds = Smooth(m_churnMilliseconds, std::chrono::duration<float, std::milli>(clock_t::now() - start).count());
+	}
+	void OnRender() override
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		const auto start = clock_t::now();
+		m_pool.WriteQuads(m_vertices.data(), m_spriteSize);
+		m_buildMilliseconds = Smooth(m_buildMilliseconds, std::chrono::duration<float, std::milli>(clock_t::now() - start).count());
+
+		const std::size_t count = m_pool.GetCount();
+		if (count == 0) return;
+		m_batch.SetData(m_vertices.data(), count);
+
+		m_command.Clear();
+		m_command.Add(unsigned(count * 6), 0, 0);
+
+		m_chernoTex->Bind(0); m_hazelTex->Bind(1);
+		m_shader->Bind();
+		m_shader->SetUniformMat4f("u_MVP", m_proj);
+		m_shader->SetTextureSlots("u_Textures");
+		m_renderer.DrawIndirect(m_batch.GetVertexArray(), m_batch.GetIndexBuffer(), m_command, *m_shader);
+	}
+	void OnImGuiRender() override
+	{
+		ImGui::SliderInt("Sprites", &m_spriteCount, 1000, 500000, "%d", ImGuiSliderFlags_Logarithmic);
+		if (ImGui::IsItemDeactivatedAfterEdit()) Populate();
+		ImGui::SliderFloat("Size", &m_spriteSize, 2.0f, 64.0f, "%.0f");
+		ImGui::SliderFloat("Churn %", &m_churn, 0.0f, 10.0f, "%.1f");
+
+		ImGui::Text("Kernels (integrate + bounce): %.2f ms", double(m_kernelMilliseconds));
+		ImGui::Text("Churn (remove + add): %.2f ms", double(m_churnMilliseconds));
+		ImGui::Text("Batch build (%zu quads): %.2f ms", m_pool.GetCount(), double(m_buildMilliseconds));
+	}
+
+private:
+	SpritePool::SpriteHandle Spawn()
+	{
+		std::uniform_real_distribution<float> x(0.0f, 960.0f), y(0.0f, 720.0f), velocity(-80.0f, 80.0f), spin(-3.0f, 3.0f), scale(0.5f, 1.5f), channel(0.3f, 1.0f);
+		SpritePool::Desc desc;
+		desc.position = { x(m_random), y(m_random) };
+		desc.velocity = { velocity(m_random), velocity(m_random) };
+		desc.spin = spin(m_random);
+		desc.scale = scale(m_random);
+		desc.color = { channel(m_random), channel(m_random), channel(m_random), 1.0f };
+		desc.layer = float(m_random() & 1); // Cherno / Hazel
+		return m_pool.Add(desc);
+	}
+
+	void Populate()
+	{
+		m_pool.Clear();
+		m_handles.clear();
+		m_pool.Reserve(std::size_t(m_spriteCount));
+		for (int i = 0; i < m_spriteCount; i++)
+			m_handles.push_back(Spawn());
+
+		// the index pattern is static, only vertices are streamed
+		m_vertices.resize(std::size_t(m_spriteCount) * 4);
+		if (std::size_t(m_spriteCount) != m_batch.GetCapacity()) m_batch.Reserve(std::size_t(m_spriteCount));
+	}
+};
+
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Test.hpp"
+#include "Utility.hpp"
+
+#include "Renderer.hpp"
+#include "Font.hpp"
+#include "TextRenderer.hpp"
+
+#include <GL/glew.h>
+#include <imgui/imgui.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <chrono>
+#include <string>
+#include <algorithm>
+
+namespace test
+{
+
+// A HUD of thousands of labels drawn by the renderer itself: SDF glyphs from one atlas, one draw per frame
+// "Live values" makes every label change each step, so shaping misses the cache
+class TextRendering : public Test
+{
+	using clock_t = std::chrono::steady_clock;
+
+	Font m_font = Font("deps/imgui/misc/fonts/Roboto-Medium.ttf"); // ships with the ImGui submodule
+	TextRenderer m_text = TextRenderer(m_font);
+
+	glm::mat4 m_proj = glm::ortho(0.0f, 960.0f, 0.0f, 720.0f, -1.0f, 1.0f); // screen scale
+
+	int m_labelCount = 2000;
+	float m_labelSize = 9.0f;
+	float m_titleSize = 64.0f;
+	float m_softness = 0.7f;
+	bool m_live = false;
+	float m_time = 0.0f;
+
+	std::size_t m_glyphs = 0;
+	float m_buildMilliseconds = 0.0f;
+
+	Renderer m_renderer;
+
+public:
+	~TextRendering() {}
+	TextRendering() {}
+
+	void OnUpdate(float deltaTime = 0.0f) override { if (m_live) m_time += deltaTime; }
+	void OnRender() override
+	{
+		GLCall(glClearColor(0.05f, 0.05f, 0.08f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+		if (!m_font.IsLoaded()) return;
+
+		const auto start = clock_t::now();
+		const std::string title = "SDF text: one draw";
+		const glm::vec2 titleSize = m_text.Measure(title, m_titleSize);
+		m_text.Add(title, { (960.0f - titleSize.x) * 0.5f, 720.0f - m_titleSize }, m_titleSize, { 1.0f, 0.85f, 0.3f, 1.0f });
+
+		const float top = 720.0f - m_titleSize * 1.5f;
+		const int columns = std::max(1, int(960.0f / (m_labelSize * 7.0f)));
+		for (int i = 0; i < m_labelCount; i++)
+		{
+			const int health = m_live ? int(50.0f + 50.0f * std::sin(m_time * 2.0f + float(i))) : i % 100;
+			const glm::vec2 position = { float(i % columns) * m_labelSize * 7.0f + 2.0f, top - float(i / columns) * m_labelSize * 1.2f };
+			if (position.y < -m_labelSize) break;
+			const glm::vec4 color = { 1.0f - float(health) / 100.0f, float(health) / 100.0f, 0.4f, 1.0f };
+			m_text.Add("#" + std::to_string(i) + " hp " + std::to_string(health), position, m_labelSize, color);
+		}
+		m_buildMilliseconds = Smooth(m_buildMilliseconds, std::chrono::duration<float, std::milli>(clock_t::now() - start).count());
+
+		m_text.SetSoftness(m_softness);
+		m_glyphs = m_text.Flush(m_renderer, m_proj);
+	}
+	void OnImGuiRender() override
+	{
+		if (!m_font.IsLoaded()) { ImGui::Text("Font failed to load, see the console"); return; }
+
+		ImGui::SliderInt("Labels", &m_labelCount, 0, 20000, "%d", ImGuiSliderFlags_Logarithmic);
+		ImGui::SliderFloat("Label size", &m_labelSize, 4.0f, 48.0f, "%.1f");
+		ImGui::SliderFloat("Title size", &m_titleSize, 8.0f, 256.0f, "%.0f", ImGuiSliderFlags_Logarithmic);
+		ImGui::SliderFloat("Softness", &m_softness, 0.1f, 8.0f, "%.2f", ImGuiSliderFlags_Logarithmic);
+		ImGui::Checkbox("Live values", &m_live);
+
+		ImGui::Text("Glyphs: %zu in 1 draw call, batch build %.2f ms", m_glyphs, double(m_buildMilliseconds));
+		ImGui::Text("Shaped strings cached: %zu, hits %zu, misses %zu", m_text.GetCachedCount(), m_text.GetHits(), m_text.GetMisses());
+		ImGui::Text("Atlas: %dx%d R8, baked at %.0fpx", m_font.GetAtlas().GetWidth(), m_font.GetAtlas().GetHeight(), double(m_font.GetBakeSize()));
+	}
+};
+
+}
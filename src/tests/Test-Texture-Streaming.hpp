@@ -0,0 +1,141 @@
+#pragma once
+
+#include "Test.hpp"
+#include "Utility.hpp"
+
+#include "Renderer.hpp"
+#include "Texture.hpp"
+#include "TextureStreamer.hpp"
+#include "VertexArray.hpp"
+#include "GpuTimer.hpp"
+#include "Assets.hpp"
+
+#include <GL/glew.h>
+#include <imgui/imgui.h>
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+
+namespace test
+{
+
+// A full 1080p RGBA8 texture replaced every frame: "video" frames decoded up front (memcpy into the upload buffer)
+// or a canvas painted straight into the mapped buffer; the PBO ring against plain `glTexSubImage2D` from client memory
+class TextureStreaming : public Test
+{
+	using clock_t = std::chrono::steady_clock;
+
+	static constexpr int s_width = 1920, s_height = 1080, s_videoFrames = 4;
+	static constexpr std::size_t s_frameBytes = std::size_t(s_width) * s_height * 4;
+
+	enum class Path : int { ring = 0, direct = 1 };
+	enum class Source : int { video = 0, painted = 1 };
+
+	Texture m_texture;
+	TextureStreamer m_streamer;
+	std::vector<std::vector<unsigned char>> m_video;
+	std::vector<unsigned char> m_canvas; // painted frame of the direct path
+	VertexArray m_fullscreen = VertexArray::Create(); // empty: the blit generates its vertices
+	AssetRef<Shader> m_blit;
+	GpuTimer m_timer;
+
+	int m_path = int(Path::ring);
+	int m_source = int(Source::video);
+	int m_ringSize = 3;
+	std::uint32_t m_frame = 0;
+
+	float m_cpuMilliseconds = 0.0f;
+	clock_t::time_point m_windowStart = clock_t::now(); // bandwidth over 1 s windows
+	std::uint64_t m_windowBytes = 0, m_windowUploads = 0, m_windowFrames = 0;
+	double m_bandwidth = 0.0, m_uploadsPerSecond = 0.0, m_framesPerSecond = 0.0;
+
+	Renderer m_renderer;
+
+public:
+	~TextureStreaming() {}
+	TextureStreaming() : m_texture(s_width, s_height, GL_RGBA8, GL_RGBA, nullptr)
+	{
+		m_video.resize(s_videoFrames);
+		for (int i = 0; i < s_videoFrames; i++)
+		{
+			m_video[std::size_t(i)].resize(s_frameBytes);
+			Paint(m_video[std::size_t(i)].data(), std::uint32_t(i) * 64u);
+		}
+		m_canvas.resize(s_frameBytes);
+		m_blit = Assets::LoadShader("res/Shaders/Blit.shader");
+	}
+
+	void OnRender() override
+	{
+		const auto start = clock_t::now();
+		bool uploaded = true;
+		m_timer.Begin();
+		if (Path(m_path) == Path::ring)
+		{
+			if (Source(m_source) == Source::video)
+				uploaded = m_streamer.Update(m_texture, 0, 0, s_width, s_height, m_video[m_frame % s_videoFrames].data());
+			else
+				uploaded = m_streamer.UpdateWith(m_texture, 0, 0, s_width, s_height, [&](unsigned char *pixels) { Paint(pixels, m_frame); });
+		}
+		else
+		{ // the driver copies client memory before returning, possibly waiting for the texture to go idle
+			const unsigned char *pixels = m_video[m_frame % s_videoFrames].data();
+			if (Source(m_source) == Source::painted) { Paint(m_canvas.data(), m_frame); pixels = m_canvas.data(); }
+			m_texture.SetSubImage(0, 0, s_width, s_height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+		}
+		m_timer.End();
+		m_cpuMilliseconds = Smooth(m_cpuMilliseconds, std::chrono::duration<float, std::milli>(clock_t::now() - start).count());
+		if (uploaded) { m_frame++; m_windowBytes += s_frameBytes; m_windowUploads++; }
+		m_windowFrames++;
+
+		const double window = std::chrono::duration<double>(clock_t::now() - m_windowStart).count();
+		if (window >= 1.0)
+		{
+			m_bandwidth = double(m_windowBytes) / window;
+			m_uploadsPerSecond = double(m_windowUploads) / window;
+			m_framesPerSecond = double(m_windowFrames) / window;
+			m_windowBytes = m_windowUploads = m_windowFrames = 0;
+			m_windowStart = clock_t::now();
+		}
+
+		m_texture.Bind(0);
+		m_blit->Bind();
+		m_blit->SetUniform1i("u_Texture", 0);
+		m_renderer.DrawFullscreen(m_fullscreen, *m_blit);
+	}
+	void OnImGuiRender() override
+	{
+		const char *paths[] = { "PBO ring (async)", "glTexSubImage2D from client memory" };
+		ImGui::Combo("Upload", &m_path, paths, IM_ARRAYSIZE(paths));
+		const char *sources[] = { "Video (pre-decoded frames)", "Canvas (painted per frame)" };
+		ImGui::Combo("Source", &m_source, sources, IM_ARRAYSIZE(sources));
+		ImGui::BeginDisabled(Path(m_path) != Path::ring);
+		ImGui::SliderInt("Ring size", &m_ringSize, 1, TextureStreamer::s_maxRingSize);
+		if (ImGui::IsItemDeactivatedAfterEdit()) m_streamer.SetRingSize(m_ringSize);
+		ImGui::EndDisabled();
+
+		ImGui::Text("%dx%d RGBA8, %.2f MiB per upload", s_width, s_height, double(s_frameBytes) / (1 << 20));
+		ImGui::Text("Upload bandwidth: %.0f MiB/s (%.1f uploads/s at %.1f FPS)", m_bandwidth / (1 << 20), m_uploadsPerSecond, m_framesPerSecond);
+		ImGui::Text("CPU %.3f ms / frame, GPU %.3f ms / frame", double(m_cpuMilliseconds), double(m_timer.GetMilliseconds()));
+		ImGui::Text("Ring: %llu uploads, %llu skipped (all buffers in flight)",
+			static_cast<unsigned long long>(m_streamer.GetUploads()), static_cast<unsigned long long>(m_streamer.GetBusy()));
+	}
+
+private:
+	// Scrolling gradient with a moving XOR pattern, written strictly in order (the destination may be write-combined)
+	static void Paint(unsigned char *pixels, std::uint32_t frame)
+	{
+		for (int y = 0; y < s_height; y++)
+			for (int x = 0; x < s_width; x++)
+			{
+				const std::uint32_t u = std::uint32_t(x) + frame * 4u, v = std::uint32_t(y) + frame * 2u;
+				*pixels++ = static_cast<unsigned char>(u);
+				*pixels++ = static_cast<unsigned char>(v);
+				*pixels++ = static_cast<unsigned char>((u ^ v) >> 1);
+				*pixels++ = 255;
+			}
+	}
+};
+
+}
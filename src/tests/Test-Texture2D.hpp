@@ -4,16 +4,17 @@
 #include "Utility.hpp"
 
 #include "Renderer.hpp"
+#include "Camera.hpp"
 #include "VertexBuffer.hpp"
 #include "VertexBufferLayout.hpp"
 #include "Texture.hpp"
+#include "Assets.hpp"
 
 #include <GL/glew.h>
 #include <imgui/imgui.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
-#include <memory>
 #include <type_traits>
 
 namespace test
@@ -21,14 +22,13 @@ namespace test
 
 class TestTexture2D : public Test
 {
-	std::unique_ptr<VertexArray> m_vao;
-	std::unique_ptr<IndexBuffer> m_indexBuffer;
-	std::unique_ptr<VertexBuffer> m_vertexBuffer;
-	std::unique_ptr<Shader> m_shader;
-	std::unique_ptr<Texture> m_texture;
-
-	glm::mat4 m_proj = glm::ortho(0.0f, 960.0f, 0.0f, 720.0f, -1.0f, 1.0f);
-	glm::mat4 m_view = glm::translate(glm::mat4(1.0f), glm::vec3(-100, 0, 0));
+	VertexArray m_vao = VertexArray::Create();
+	IndexBuffer m_indexBuffer;
+	VertexBuffer m_vertexBuffer;
+	AssetRef<Shader> m_shader;
+	AssetRef<Texture> m_texture;
+
+	Camera m_camera = Camera(0.0f, 960.0f, 0.0f, 720.0f); // screen scale, view-projection cached
 	glm::vec3 m_translationA = glm::vec3(200, 200, 0);
 	glm::vec3 m_translationB = glm::vec3(400, 200, 0);
 
@@ -38,6 +38,7 @@ public:
 	~TestTexture2D() {}
 	TestTexture2D()
 	{
+		m_camera.SetPosition(glm::vec2(100.0f, 0.0f));
 		float positions[] = { // pos[x,y...]
 			-50.0f, -50.0f, 0.0f, 0.0f, // 0
 			 50.0f, -50.0f, 1.0f, 0.0f, // 1
@@ -53,20 +54,18 @@ public:
 		GLCall(glEnable(GL_BLEND));
 		GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
 
-		m_vao = std::make_unique<VertexArray>();
-
 		static_assert(sizeof(float) == sizeof(std::remove_extent_t<decltype(positions)>));
-		m_vertexBuffer = std::make_unique<VertexBuffer>(positions, unsigned(4 * 4 * sizeof(std::remove_extent_t<decltype(positions)>)));
+		m_vertexBuffer = VertexBuffer(positions, unsigned(4 * 4 * sizeof(std::remove_extent_t<decltype(positions)>)));
 		VertexBufferLayout layout;
 		layout.Push<float>(2);
 		layout.Push<float>(2);
-		m_vao->AddBuffer(*m_vertexBuffer, layout);
+		m_vao.AddBuffer(m_vertexBuffer, layout);
 
-		m_indexBuffer = std::make_unique<IndexBuffer>(indices, 6);
+		m_indexBuffer = IndexBuffer(indices, 6);
 
-		m_texture = std::make_unique<Texture>("res/textures/ChernoLogo.png");
+		m_texture = Assets::LoadTexture("res/textures/ChernoLogo.png");
 
-		m_shader = std::make_unique<Shader>("res/Shaders/Basic.shader");
+		m_shader = Assets::LoadShader("res/Shaders/Basic.shader");
 		m_shader->Bind();
 		m_shader->SetUniform1i("u_Texture", 0);
 	}
@@ -81,22 +80,22 @@ public:
 
 		{
 			glm::mat4 model = glm::translate(glm::mat4(1.0f), m_translationA);
-			glm::mat4 mvp = m_proj * m_view * model;
+			glm::mat4 mvp = m_camera.GetViewProjection() * model;
 
 			m_shader->Bind();
 			m_shader->SetUniformMat4f("u_MVP", mvp);
 
-			m_renderer.Draw(*m_vao, *m_indexBuffer, *m_shader);
+			m_renderer.Draw(m_vao, m_indexBuffer, *m_shader);
 		}
 
 		{
 			glm::mat4 model = glm::translate(glm::mat4(1.0f), m_translationB);
-			glm::mat4 mvp = m_proj * m_view * model;
+			glm::mat4 mvp = m_camera.GetViewProjection() * model;
 
 			m_shader->Bind();
 			m_shader->SetUniformMat4f("u_MVP", mvp);
 
-			m_renderer.Draw(*m_vao, *m_indexBuffer, *m_shader);
+			m_renderer.Draw(m_vao, m_indexBuffer, *m_shader);
 		}
 	}
 	void OnImGuiRender() override
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "Test.hpp"
+#include "Utility.hpp"
+
+#include "Renderer.hpp"
+#include "Texture.hpp"
+#include "SpriteBatch.hpp"
+#include "FrameState.hpp"
+
+#include <GL/glew.h>
+#include <imgui/imgui.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdint>
+
+namespace test
+{
+
+// Bodies pulled around by moving attractors, plus a configurable chunk of busy work per step standing in for
+// heavier game logic. Serial: every step of the frame runs before `OnRender`; with "Threaded simulation" on, steps run
+// on the simulation thread and the frame only draws the newest published snapshot
+class ThreadedSimulation : public Test
+{
+	using clock_t = std::chrono::steady_clock;
+
+	struct Body { glm::vec2 position, velocity; };
+	struct Snapshot
+	{
+		std::vector<glm::vec2> positions;
+		std::uint64_t step = 0;
+	};
+
+	// simulation side (`OnUpdate`, whichever thread runs it)
+	std::vector<Body> m_bodies;
+	std::mt19937 m_random{ 5 };
+	std::uint64_t m_step = 0;
+	float m_time = 0.0f;
+	float m_updateAverage = 0.0f;
+
+	// shared
+	FrameState<Snapshot> m_state;
+	std::atomic<int> m_bodyCount{ 20000 };
+	std::atomic<float> m_workMilliseconds{ 2.0f }; // busy work per step
+	std::atomic<float> m_updateMilliseconds{ 0.0f };
+
+	// render side
+	SpriteBatch m_batch;
+	Texture m_white;
+	glm::mat4 m_proj = glm::ortho(0.0f, 960.0f, 0.0f, 720.0f, -1.0f, 1.0f);
+	std::uint64_t m_shownStep = 0;
+	float m_stepsPerFrame = 0.0f; // smoothed, 0 - the frame repeated the previous snapshot
+	float m_renderMilliseconds = 0.0f;
+	int m_bodyCountUi = m_bodyCount;
+	float m_workMillisecondsUi = m_workMilliseconds;
+
+	Renderer m_renderer;
+
+public:
+	~ThreadedSimulation() {}
+	ThreadedSimulation()
+	{
+		const unsigned char white[4] = { 255, 255, 255, 255 };
+		m_white = Texture(1, 1, GL_RGBA8, GL_RGBA, white);
+		m_batch.SetMode(SpriteBatch::Mode::blended);
+	}
+
+	bool SupportsThreadedUpdate() const override { return true; }
+
+	void OnUpdate(float deltaTime = 0.0f) override
+	{
+		const auto start = clock_t::now();
+		if (m_bodies.size() != std::size_t(m_bodyCount.load(std::memory_order_relaxed))) Populate();
+
+		m_time += deltaTime;
+		glm::vec2 attractors[3];
+		for (int i = 0; i < 3; i++)
+		{
+			const float angle = m_time * (0.3f + 0.2f * float(i)) + 2.094f * float(i);
+			attractors[i] = glm::vec2(480.0f + 260.0f * std::cos(angle), 360.0f + 220.0f * std::sin(angle * 1.3f));
+		}
+		for (Body &body : m_bodies)
+		{
+			glm::vec2 acceleration(0.0f);
+			for (const glm::vec2 &attractor : attractors)
+			{
+				const glm::vec2 offset = attractor - body.position;
+				const float distanceSq = glm::dot(offset, offset) + 400.0f; // softened
+				acceleration += offset * (2.0e6f / (distanceSq * std::sqrt(distanceSq)));
+			}
+			body.velocity = (body.velocity + acceleration * deltaTime) * 0.998f;
+			body.position += body.velocity * deltaTime;
+		}
+
+		// stand-in for AI/physics/scripting that doesn't vectorise away
+		const auto workEnd = start + std::chrono::duration_cast<clock_t::duration>(std::chrono::duration<float, std::milli>(m_workMilliseconds.load(std::memory_order_relaxed)));
+		while (clock_t::now() < workEnd) {}
+
+		Snapshot &snapshot = m_state.GetWrite(); // an older snapshot: overwritten completely
+		snapshot.positions.resize(m_bodies.size());
+		for (std::size_t i = 0; i < m_bodies.size(); i++)
+			snapshot.positions[i] = m_bodies[i].position;
+		snapshot.step = ++m_step;
+		m_state.Publish();
+
+		m_updateAverage += (std::chrono::duration<float, std::milli>(clock_t::now() - start).count() - m_updateAverage) * 0.1f;
+		m_updateMilliseconds.store(m_updateAverage, std::memory_order_relaxed);
+	}
+	void OnRender() override
+	{
+		const auto start = clock_t::now();
+		GLCall(glClearColor(0.02f, 0.02f, 0.04f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+
+		const bool fresh = m_state.Acquire();
+		const Snapshot &snapshot = m_state.GetRead();
+		m_stepsPerFrame += (float(fresh ? snapshot.step - m_shownStep : 0) - m_stepsPerFrame) * 0.05f;
+		m_shownStep = snapshot.step;
+
+		static const glm::vec4 colors[] = { { 1.0f, 0.6f, 0.2f, 0.8f }, { 0.3f, 0.7f, 1.0f, 0.8f }, { 0.6f, 1.0f, 0.4f, 0.8f } };
+		m_white.Bind(0);
+		m_batch.Reserve(snapshot.positions.size());
+		for (std::size_t i = 0; i < snapshot.positions.size(); i++)
+			m_batch.Add({ glm::vec2(snapshot.positions[i].x - 1.5f, snapshot.positions[i].y - 1.5f), glm::vec2(3.0f), colors[i % 3], 0.0f, 0.0f });
+		m_batch.Flush(m_renderer, m_proj);
+		m_renderMilliseconds += (std::chrono::duration<float, std::milli>(clock_t::now() - start).count() - m_renderMilliseconds) * 0.1f;
+	}
+	void OnImGuiRender() override
+	{
+		if (ImGui::SliderInt("Bodies", &m_bodyCountUi, 1000, 200000, "%d", ImGuiSliderFlags_Logarithmic))
+			m_bodyCount.store(m_bodyCountUi, std::memory_order_relaxed);
+		if (ImGui::SliderFloat("Extra work / step (ms)", &m_workMillisecondsUi, 0.0f, 10.0f, "%.1f"))
+			m_workMilliseconds.store(m_workMillisecondsUi, std::memory_order_relaxed);
+
+		ImGui::Text("Update %.3f ms / step, render (CPU) %.3f ms", double(m_updateMilliseconds.load(std::memory_order_relaxed)), double(m_renderMilliseconds));
+		ImGui::Text("Snapshot step %llu, %.2f steps / frame", static_cast<unsigned long long>(m_shownStep), double(m_stepsPerFrame));
+		ImGui::TextDisabled("Toggle \"Threaded simulation\" and compare frame times");
+	}
+
+private:
+	void Populate()
+	{
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		m_bodies.resize(std::size_t(m_bodyCount.load(std::memory_order_relaxed)));
+		for (Body &body : m_bodies)
+		{
+			body.position = glm::vec2(unit(m_random) * 960.0f, unit(m_random) * 720.0f);
+			body.velocity = glm::vec2(unit(m_random) * 2.0f - 1.0f, unit(m_random) * 2.0f - 1.0f) * 50.0f;
+		}
+	}
+};
+
+}
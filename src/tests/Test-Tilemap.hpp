@@ -0,0 +1,181 @@
+#pragma once
+
+#include "Test.hpp"
+#include "Utility.hpp"
+
+#include "Renderer.hpp"
+#include "Texture.hpp"
+#include "Tilemap.hpp"
+#include "Camera.hpp"
+#include "Assets.hpp"
+
+#include <GL/glew.h>
+#include <imgui/imgui.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace test
+{
+
+// Procedural terrain on maps up to 4096x4096 tiles: only chunks on screen are built and drawn,
+// painting (LMB) or random edits rebuild just the touched chunks
+class TilemapChunks : public Test
+{
+	using clock_t = std::chrono::steady_clock;
+
+	enum Terrain : Tilemap::Tile { deepWater, water, sand, grass, forest, rock, snow, brick, terrainCount };
+
+	std::unique_ptr<Tilemap> m_map;
+	Texture m_tileset;
+	AssetRef<Shader> m_shader;
+	std::mt19937 m_random{ 7 };
+
+	Camera m_view = Camera(0.0f, 960.0f, 0.0f, 720.0f); // screen scale, view-projection cached between pans/zooms
+	glm::vec2 m_camera = glm::vec2(0.0f);
+	float m_zoom = 1.0f;
+	bool m_autoPan = false;
+
+	int m_mapSize = 1024;
+	int m_chunkSize = 32;
+	int m_editsPerStep = 0;
+
+	float m_drawMilliseconds = 0.0f;
+
+	Renderer m_renderer;
+
+public:
+	~TilemapChunks() {}
+	TilemapChunks()
+	{
+		m_shader = Assets::LoadShader("res/Shaders/Batch-Textures.shader");
+
+		m_tileset = CreateTileset();
+		Generate();
+	}
+
+	void OnUpdate(float deltaTime = 0.0f) override
+	{
+		if (m_autoPan) m_camera += glm::vec2(240.0f, 90.0f) * deltaTime / m_zoom;
+
+		std::uniform_int_distribution<int> coordinate(0, m_mapSize - 1);
+		for (int i = 0; i < m_editsPerStep; i++)
+			m_map->Set(coordinate(m_random), coordinate(m_random), Tilemap::Tile(m_random() % terrainCount));
+	}
+	void OnRender() override
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		const Bounds world = m_map->GetBounds();
+		const glm::vec2 viewSize = glm::vec2(960.0f, 720.0f) / m_zoom;
+		m_camera = glm::clamp(m_camera, world.min, glm::max(world.max - viewSize, world.min));
+
+		const ImGuiIO &io = ImGui::GetIO();
+		if (io.MouseDown[0] && !io.WantCaptureMouse && io.DisplaySize.x > 0.0f && io.DisplaySize.y > 0.0f)
+		{
+			const glm::vec2 mouse = m_camera + glm::vec2(io.MousePos.x / io.DisplaySize.x, 1.0f - io.MousePos.y / io.DisplaySize.y) * viewSize;
+			const glm::ivec2 tile = glm::ivec2(glm::floor(mouse / m_map->GetTileSize()));
+			for (int y = tile.y - 1; y <= tile.y + 1; y++) // 3x3 brush, may straddle chunks
+				for (int x = tile.x - 1; x <= tile.x + 1; x++)
+					if (x >= 0 && y >= 0 && x < m_map->GetWidth() && y < m_map->GetHeight()) m_map->Set(x, y, brick);
+		}
+
+		m_view.SetPosition(m_camera);
+		m_view.SetZoom(m_zoom);
+		glm::mat4 mvp = m_view.GetViewProjection();
+		m_tileset.Bind(0);
+		m_shader->Bind();
+		m_shader->SetUniformMat4f("u_MVP", mvp);
+		m_shader->SetTextureSlots("u_Textures");
+
+		const auto start = clock_t::now();
+		m_map->Draw(m_renderer, *m_shader, { m_camera, m_camera + viewSize });
+		m_drawMilliseconds = Smooth(m_drawMilliseconds, std::chrono::duration<float, std::milli>(clock_t::now() - start).count());
+	}
+	void OnImGuiRender() override
+	{
+		ImGui::SliderInt("Map size", &m_mapSize, 64, 4096, "%d tiles", ImGuiSliderFlags_Logarithmic);
+		bool regenerate = ImGui::IsItemDeactivatedAfterEdit();
+		ImGui::SliderInt("Chunk size", &m_chunkSize, 8, 128, "%d tiles", ImGuiSliderFlags_Logarithmic);
+		regenerate |= ImGui::IsItemDeactivatedAfterEdit();
+		if (regenerate) Generate();
+
+		ImGui::SliderFloat2("Camera", &m_camera.x, 0.0f, float(m_mapSize) * m_map->GetTileSize());
+		ImGui::SliderFloat("Zoom", &m_zoom, 0.05f, 4.0f, "%.2f", ImGuiSliderFlags_Logarithmic);
+		ImGui::Checkbox("Auto pan", &m_autoPan);
+		ImGui::SliderInt("Random edits / step", &m_editsPerStep, 0, 1000, "%d", ImGuiSliderFlags_Logarithmic);
+		if (ImGui::Button("Release hidden chunks"))
+			m_map->ReleaseHidden({ m_camera, m_camera + glm::vec2(960.0f, 720.0f) / m_zoom });
+
+		const Tilemap::Stats &stats = m_map->GetStats();
+		ImGui::Text("Chunks: %zu total, %zu visible, %zu drawn, %zu built (%.2f MiB)",
+			m_map->GetChunkCount(), stats.visibleChunks, stats.drawnChunks, stats.builtChunks, double(stats.bytes) / (1 << 20));
+		ImGui::Text("Quads: %zu, rebuilds this frame: %zu, CPU %.3f ms", stats.quads, stats.rebuilds, double(m_drawMilliseconds));
+		ImGui::TextUnformatted("LMB - paint bricks");
+	}
+
+private:
+	void Generate()
+	{
+		m_map = std::make_unique<Tilemap>(m_mapSize, m_mapSize, 16.0f, m_chunkSize, 4);
+		m_map->Fill([](int x, int y) {
+			// 3 octaves of value noise -> height -> terrain band
+			float height = 0.0f, amplitude = 0.5f;
+			for (int octave = 0, period = 64; octave < 3; octave++, period /= 2, amplitude *= 0.5f)
+				height += amplitude * ValueNoise(float(x) / float(period), float(y) / float(period), std::uint32_t(octave));
+			const float bands[] = { 0.30f, 0.40f, 0.44f, 0.58f, 0.68f, 0.78f };
+			Tilemap::Tile tile = 0;
+			while (tile < 6 && height > bands[tile]) tile++;
+			return tile; // deepWater..snow
+		});
+	}
+
+	static float Hash(int x, int y, std::uint32_t seed)
+	{
+		std::uint32_t h = std::uint32_t(x) * 374761393u + std::uint32_t(y) * 668265263u + seed * 2246822519u;
+		h = (h ^ (h >> 13)) * 1274126177u;
+		return float((h ^ (h >> 16)) & 0xFFFFu) / 65535.0f;
+	}
+
+	static float ValueNoise(float x, float y, std::uint32_t seed)
+	{
+		const int ix = int(std::floor(x)), iy = int(std::floor(y));
+		const float fx = x - float(ix), fy = y - float(iy);
+		const float sx = fx * fx * (3.0f - 2.0f * fx), sy = fy * fy * (3.0f - 2.0f * fy);
+		const float bottom = Hash(ix, iy, seed) + (Hash(ix + 1, iy, seed) - Hash(ix, iy, seed)) * sx;
+		const float top = Hash(ix, iy + 1, seed) + (Hash(ix + 1, iy + 1, seed) - Hash(ix, iy + 1, seed)) * sx;
+		return bottom + (top - bottom) * sy;
+	}
+
+	// 4x4 cells of 16x16 texels: a noisy base colour per terrain
+	static Texture CreateTileset()
+	{
+		constexpr int cell = 16, columns = 4, size = cell * columns;
+		const unsigned char colors[terrainCount][3] = {
+			{ 20, 40, 110 }, { 40, 90, 170 }, { 210, 190, 130 }, { 70, 150, 60 },
+			{ 30, 95, 40 }, { 120, 115, 110 }, { 235, 240, 245 }, { 150, 60, 40 } };
+
+		std::vector<unsigned char> pixels(std::size_t(size) * size * 4, 255);
+		for (int tile = 0; tile < terrainCount; tile++)
+			for (int y = 0; y < cell; y++)
+				for (int x = 0; x < cell; x++)
+				{
+					float shade = 0.85f + 0.3f * Hash(x, y, std::uint32_t(tile + 11));
+					if (tile == brick && (y % 4 == 0 || (x + (y / 4 % 2) * 4) % 8 == 0)) shade = 0.55f; // mortar
+					unsigned char *texel = &pixels[(std::size_t(tile / columns * cell + y) * size + tile % columns * cell + x) * 4];
+					for (int channel = 0; channel < 3; channel++)
+						texel[channel] = (unsigned char)std::min(255.0f, float(colors[tile][channel]) * shade);
+				}
+		return Texture(size, size, GL_RGBA8, GL_RGBA, pixels.data());
+	}
+};
+
+}
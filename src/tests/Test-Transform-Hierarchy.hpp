@@ -0,0 +1,192 @@
+#pragma once
+
+#include "Test.hpp"
+#include "Utility.hpp"
+
+#include "Renderer.hpp"
+#include "Camera.hpp"
+#include "Transform.hpp"
+#include "VertexArray.hpp"
+#include "VertexBuffer.hpp"
+#include "IndexBuffer.hpp"
+#include "Assets.hpp"
+
+#include <GL/glew.h>
+#include <imgui/imgui.h>
+#include <glm/glm.hpp>
+
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace test
+{
+
+// 100k-node tree (a b-ary fractal, or one long chain) where only a few percent of the nodes sway each frame:
+// dirty-flag updates recompute just the moved subtrees, the baseline recomputes every world matrix
+class TransformHierarchyBenchmark : public Test
+{
+	using clock_t = std::chrono::steady_clock;
+	using Node = TransformHierarchy::Node;
+
+	static constexpr Node s_mergeGap = 16; // nodes: closer runs of changed quads share one upload
+
+	struct ColorVertex { float x, y, r, g, b, a; }; // `Batch.shader`
+
+	TransformHierarchy m_hierarchy;
+	std::vector<Node> m_moving;
+	std::vector<float> m_restRotation; // per moving node
+	std::vector<Node> m_changed;       // last update, ascending
+	std::mt19937 m_random{ 5 };
+
+	Camera m_camera = Camera(0.0f, 960.0f, 0.0f, 720.0f); // screen scale, view-projection cached
+	glm::vec2 m_pan = glm::vec2(0.0f);
+	float m_zoom = 1.0f;
+
+	std::vector<ColorVertex> m_vertices;
+	VertexBuffer m_vertexBuffer;
+	VertexArray  m_vao;
+	IndexBuffer  m_indexBuffer;
+	AssetRef<Shader> m_shader;
+
+	int m_nodeCount = 100000;
+	int m_branching = 2;
+	float m_movingShare = 0.02f;
+	bool m_dirtyFlags = true;
+	bool m_animate = true;
+	float m_time = 0.0f;
+
+	float m_updateMilliseconds = 0.0f, m_writeMilliseconds = 0.0f;
+	std::size_t m_recomputed = 0, m_uploads = 0;
+
+	Renderer m_renderer;
+
+public:
+	~TransformHierarchyBenchmark() {}
+	TransformHierarchyBenchmark()
+	{
+		m_shader = Assets::LoadShader("res/Shaders/Batch.shader");
+		Build();
+	}
+
+	void OnUpdate(float deltaTime = 0.0f) override
+	{
+		if (!m_animate) return;
+		m_time += deltaTime;
+		for (std::size_t i = 0; i < m_moving.size(); i++) // setters only: matrices wait for `Update()`
+			m_hierarchy.SetRotation(m_moving[i], m_restRotation[i] + 0.25f * std::sin(m_time * 2.0f + float(i)));
+	}
+	void OnRender() override
+	{
+		GLCall(glClearColor(0.02f, 0.03f, 0.05f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		auto start = clock_t::now();
+		m_recomputed = m_dirtyFlags ? m_hierarchy.Update() : m_hierarchy.UpdateAll();
+		m_updateMilliseconds = Smooth(m_updateMilliseconds, std::chrono::duration<float, std::milli>(clock_t::now() - start).count());
+
+		// re-write only the quads of changed nodes, upload each run of them (runs a few nodes apart are merged:
+		// the unchanged quads in between are current anyway and one call is cheaper than two)
+		start = clock_t::now();
+		m_changed.assign(m_hierarchy.GetChanged().begin(), m_hierarchy.GetChanged().end());
+		std::sort(m_changed.begin(), m_changed.end());
+		m_uploads = 0;
+		for (std::size_t i = 0; i < m_changed.size();)
+		{
+			const Node first = m_changed[i];
+			Node last = first;
+			for (; i < m_changed.size() && m_changed[i] <= last + s_mergeGap; i++)
+			{
+				WriteQuad(m_changed[i]);
+				last = m_changed[i];
+			}
+			const std::size_t vertex = std::size_t(first) * 4, count = (std::size_t(last) - first + 1) * 4;
+			m_vertexBuffer.SetData(&m_vertices[vertex], unsigned(count * sizeof(ColorVertex)), unsigned(vertex * sizeof(ColorVertex)));
+			m_uploads++;
+		}
+		m_writeMilliseconds = Smooth(m_writeMilliseconds, std::chrono::duration<float, std::milli>(clock_t::now() - start).count());
+
+		m_camera.SetPosition(m_pan);
+		m_camera.SetZoom(m_zoom);
+		glm::mat4 mvp = m_camera.GetViewProjection(); // recomputed only after a pan/zoom
+		m_shader->Bind();
+		m_shader->SetUniformMat4f("u_MVP", mvp);
+		m_renderer.Draw(m_vao, m_indexBuffer, *m_shader);
+	}
+	void OnImGuiRender() override
+	{
+		ImGui::SliderInt("Nodes", &m_nodeCount, 1000, 200000, "%d", ImGuiSliderFlags_Logarithmic);
+		bool rebuild = ImGui::IsItemDeactivatedAfterEdit();
+		ImGui::SliderInt("Branching (1 - chain)", &m_branching, 1, 8);
+		rebuild |= ImGui::IsItemDeactivatedAfterEdit();
+		ImGui::SliderFloat("Moving share", &m_movingShare, 0.0f, 0.2f, "%.3f");
+		if (rebuild || ImGui::IsItemDeactivatedAfterEdit()) Build();
+
+		ImGui::Checkbox("Dirty flags (unchecked: recompute all)", &m_dirtyFlags);
+		ImGui::SameLine();
+		ImGui::Checkbox("Animate", &m_animate);
+		ImGui::SliderFloat2("Pan", &m_pan.x, -960.0f, 960.0f);
+		ImGui::SliderFloat("Zoom", &m_zoom, 0.1f, 10.0f, "%.2f", ImGuiSliderFlags_Logarithmic);
+
+		ImGui::Text("Moving nodes: %zu, world matrices recomputed: %zu / %zu", m_moving.size(), m_recomputed, m_hierarchy.GetCount());
+		ImGui::Text("Hierarchy update %.3f ms, quad rewrite + upload %.3f ms (%zu uploads)", double(m_updateMilliseconds), double(m_writeMilliseconds), m_uploads);
+		ImGui::Text("Camera view-projection recomputed %llu times", (unsigned long long)m_camera.GetVersion());
+	}
+
+private:
+	void Build()
+	{
+		m_hierarchy.Clear();
+		m_hierarchy.Reserve(std::size_t(m_nodeCount));
+
+		// b-ary tree: node i hangs off (i - 1) / b, children fan out and shrink; a chain winds into a spiral
+		const bool chain = m_branching == 1;
+		m_hierarchy.Create(TransformHierarchy::s_none, { glm::vec3(480.0f, chain ? 360.0f : 60.0f, 0.0f), 0.0f, glm::vec3(chain ? 0.6f : 110.0f) });
+		for (int i = 1; i < m_nodeCount; i++)
+		{
+			const Node parent = Node((i - 1) / m_branching);
+			const float sibling = float((i - 1) % m_branching) - float(m_branching - 1) * 0.5f;
+			TransformHierarchy::Local local;
+			if (chain) local = { glm::vec3(1.0f, 0.0f, 0.0f), 6.2831853f / 5000.0f, glm::vec3(1.0f) };
+			else local = { glm::vec3(0.0f, 1.0f, 0.0f), sibling * 1.4f / float(m_branching), glm::vec3(0.7f) };
+			m_hierarchy.Create(parent, local);
+		}
+
+		m_moving.clear();
+		m_restRotation.clear();
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		for (Node node = 1; node < Node(m_nodeCount); node++)
+			if (unit(m_random) < m_movingShare)
+			{
+				m_moving.push_back(node);
+				m_restRotation.push_back(m_hierarchy.GetLocal(node).rotation);
+			}
+
+		m_vertices.assign(std::size_t(m_nodeCount) * 4, {});
+		m_vertexBuffer = VertexBuffer::CreateDynamic(unsigned(m_vertices.size() * sizeof(ColorVertex)));
+		m_vao = VertexArray::Create();
+		VertexBufferLayout layout;
+		layout.Push<float>(2); // coord xy
+		layout.Push<float>(4); // color rgba
+		m_vao.AddBuffer(m_vertexBuffer, layout);
+		m_indexBuffer = IndexBuffer::CreateQuads(unsigned(m_nodeCount));
+	}
+
+	// Square of half-size 0.15 around the node origin in its own space
+	void WriteQuad(Node node)
+	{
+		const glm::mat4 &world = m_hierarchy.GetWorld(node);
+		const glm::vec2 origin(world[3].x, world[3].y), axisX(world[0].x * 0.15f, world[0].y * 0.15f), axisY(world[1].x * 0.15f, world[1].y * 0.15f);
+		const float shade = float(node % 7) / 7.0f;
+		const float r = 0.3f + 0.5f * shade, g = 0.8f - 0.3f * shade, b = 0.4f, a = 1.0f;
+		ColorVertex *quad = &m_vertices[std::size_t(node) * 4];
+		const glm::vec2 corners[4] = { origin - axisX - axisY, origin + axisX - axisY, origin + axisX + axisY, origin - axisX + axisY };
+		for (int i = 0; i < 4; i++)
+			quad[i] = { corners[i].x, corners[i].y, r, g, b, a };
+	}
+};
+
+}
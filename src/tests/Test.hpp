@@ -1,5 +1,7 @@
 #pragma once
 
+#include "GpuMemory.hpp"
+
 #include <imgui/imgui.h>
 
 #include <iostream>
@@ -17,9 +19,14 @@ public:
 	Test() {}
 	virtual ~Test() {}
 
-	virtual void OnUpdate([[maybe_unused]] float deltaTime = 0.0f) {}
+	virtual void OnUpdate([[maybe_unused]] float deltaTime = 0.0f) {} // called with a fixed step (zero or more times per frame)
+	virtual void OnInterpolate([[maybe_unused]] float alpha) {}       // blend factor between the last two `OnUpdate` states
 	virtual void OnRender() {}
 	virtual void OnImGuiRender() {}
+
+	// Opt-in to the threaded main loop: `OnUpdate` then runs on the simulation thread, concurrently with `OnRender`
+	// and `OnImGuiRender` (`OnInterpolate` isn't called) - state shared with them goes through a `FrameState` or atomics
+	virtual bool SupportsThreadedUpdate() const { return false; }
 };
 
 class TestMenu : public Test
@@ -40,7 +47,10 @@ public:
 		for (auto &test : m_tests)
 		{
 			if (ImGui::Button(test.first.c_str()))
+			{
+				GpuMemory::Get().SetOwner(test.first); // everything the test allocates, until it is left
 				m_currentTest = test.second();
+			}
 		}
 	}
 
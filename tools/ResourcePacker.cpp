@@ -0,0 +1,82 @@
+// Offline resource packer: loose files -> single indexed `.pack` archive (see `src/ResourcePack.hpp`)
+// usage: ResourcePacker <output.pack> <root> <file>... (entries are named by their generic path relative to <root>)
+
+#include "ResourcePack.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <algorithm>
+#include <filesystem>
+
+int main(int argc, char *argv[])
+{
+	if (argc < 3)
+	{ std::cerr << "Usage: " << argv[0] << " <output.pack> <root> <file>...\n"; return EXIT_FAILURE; }
+
+	namespace fs = std::filesystem;
+	const fs::path root = fs::absolute(argv[2]);
+
+	struct File { std::string name; std::vector<char> data; };
+	std::vector<File> files;
+	for (int i = 3; i < argc; i++)
+	{
+		const fs::path path = fs::absolute(argv[i]);
+		std::ifstream stream(path, std::ios::binary);
+		if (!stream)
+		{ std::cerr << "Error: fail to open: " << path << std::endl; return EXIT_FAILURE; }
+
+		files.push_back({ path.lexically_relative(root).lexically_normal().generic_string(),
+						  std::vector<char>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()) });
+	}
+	std::sort(files.begin(), files.end(), [](const File &a, const File &b) { return a.name < b.name; });
+	if (auto dup = std::adjacent_find(files.begin(), files.end(), [](const File &a, const File &b) { return a.name == b.name; }); dup != files.end())
+	{ std::cerr << "Error: duplicate entry: " << dup->name << std::endl; return EXIT_FAILURE; }
+
+	rpak::Header header{};
+	std::memcpy(header.magic, rpak::magic, sizeof(header.magic));
+	header.version = rpak::version;
+	header.count   = std::uint32_t(files.size());
+
+	std::string names;
+	std::vector<rpak::Entry> entries(files.size());
+	for (std::size_t i = 0; i < files.size(); i++)
+	{
+		entries[i].nameOffset = std::uint32_t(names.size());
+		entries[i].nameSize   = std::uint32_t(files[i].name.size());
+		names += files[i].name;
+	}
+	header.namesSize = std::uint32_t(names.size());
+
+	auto align = [](std::uint64_t offset) { return (offset + rpak::alignment - 1) & ~std::uint64_t(rpak::alignment - 1); };
+	std::uint64_t offset = align(sizeof(header) + sizeof(rpak::Entry) * entries.size() + names.size());
+	for (std::size_t i = 0; i < files.size(); i++)
+	{
+		entries[i].offset = offset;
+		entries[i].size   = files[i].data.size();
+		offset = align(offset + files[i].data.size());
+	}
+
+	std::ofstream stream(argv[1], std::ios::binary | std::ios::trunc);
+	if (!stream)
+	{ std::cerr << "Error: fail to open output path: " << argv[1] << std::endl; return EXIT_FAILURE; }
+
+	auto pad = [&stream](std::uint64_t to) { const std::size_t n = std::size_t(to - std::uint64_t(stream.tellp())); stream.write(std::string(n, '\0').data(), std::streamsize(n)); };
+	stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	stream.write(reinterpret_cast<const char *>(entries.data()), std::streamsize(sizeof(rpak::Entry) * entries.size()));
+	stream.write(names.data(), std::streamsize(names.size()));
+	for (std::size_t i = 0; i < files.size(); i++)
+	{
+		pad(entries[i].offset);
+		stream.write(files[i].data.data(), std::streamsize(files[i].data.size()));
+	}
+	pad(offset);
+
+	std::cout << "Info: " << argv[1] << ": " << files.size() << " entries, " << offset << " bytes\n";
+	return stream ? EXIT_SUCCESS : EXIT_FAILURE;
+}
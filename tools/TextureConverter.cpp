@@ -0,0 +1,272 @@
+// Offline texture converter: <image> -> `.ctex` (pre-flipped, pre-mipmapped, optionally compressed/downconverted)
+// usage: TextureConverter <input.png> <output.ctex> [--format rgba8|rgb565|rgba4|bc1|bc3] [--no-mips]
+
+#include "TextureFile.hpp"
+
+#include <stb/stb_image.h>
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+namespace
+{
+
+struct Image
+{
+	std::uint32_t width = 0, height = 0;
+	std::vector<std::uint8_t> rgba; // 4 bytes per texel
+
+	const std::uint8_t *At(std::uint32_t x, std::uint32_t y) const // clamp-to-edge
+	{
+		x = std::min(x, width - 1);
+		y = std::min(y, height - 1);
+		return &rgba[(std::size_t(y) * width + x) * 4];
+	}
+};
+
+// 2x2 box filter (odd edges are clamped)
+Image Downsample(const Image &src)
+{
+	Image dst;
+	dst.width  = std::max(src.width / 2, 1u);
+	dst.height = std::max(src.height / 2, 1u);
+	dst.rgba.resize(std::size_t(dst.width) * dst.height * 4);
+
+	for (std::uint32_t y = 0; y < dst.height; y++)
+		for (std::uint32_t x = 0; x < dst.width; x++)
+		{
+			const std::uint8_t *p[4] = { src.At(x * 2, y * 2), src.At(x * 2 + 1, y * 2), src.At(x * 2, y * 2 + 1), src.At(x * 2 + 1, y * 2 + 1) };
+			for (int c = 0; c < 4; c++)
+				dst.rgba[(std::size_t(y) * dst.width + x) * 4 + c] = std::uint8_t((p[0][c] + p[1][c] + p[2][c] + p[3][c] + 2) / 4);
+		}
+
+	return dst;
+}
+
+std::uint16_t Pack565(int r, int g, int b) { return std::uint16_t(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255)); }
+std::uint16_t Pack4444(int r, int g, int b, int a) { return std::uint16_t(((r * 15 + 127) / 255) << 12 | ((g * 15 + 127) / 255) << 8 | ((b * 15 + 127) / 255) << 4 | ((a * 15 + 127) / 255)); }
+
+void Unpack565(std::uint16_t c, int rgb[3])
+{
+	const int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+	rgb[0] = (r << 3) | (r >> 2);
+	rgb[1] = (g << 2) | (g >> 4);
+	rgb[2] = (b << 3) | (b >> 2);
+}
+
+// BC1 color block: bounding-box endpoints (inset by 1/16) + nearest-palette indices
+// `allowPunchThrough` - use 3-color mode with transparent index 3 for texels with alpha < 128 (BC1 only)
+void EncodeColorBlock(const std::uint8_t block[16][4], bool allowPunchThrough, std::uint8_t out[8])
+{
+	bool transparent = false;
+	int lo[3] = { 255, 255, 255 }, hi[3] = { 0, 0, 0 };
+	for (int i = 0; i < 16; i++)
+	{
+		if (allowPunchThrough && block[i][3] < 128) { transparent = true; continue; }
+		for (int c = 0; c < 3; c++) { lo[c] = std::min(lo[c], int(block[i][c])); hi[c] = std::max(hi[c], int(block[i][c])); }
+	}
+	if (lo[0] > hi[0]) { lo[0] = lo[1] = lo[2] = hi[0] = hi[1] = hi[2] = 0; } // fully transparent block
+
+	for (int c = 0; c < 3; c++)
+	{
+		const int inset = (hi[c] - lo[c]) / 16;
+		lo[c] += inset; hi[c] -= inset;
+	}
+
+	std::uint16_t c0 = Pack565(hi[0], hi[1], hi[2]), c1 = Pack565(lo[0], lo[1], lo[2]);
+	if (transparent ? c0 > c1 : c0 < c1) std::swap(c0, c1); // c0 > c1: 4-color mode, c0 <= c1: 3-color + transparent
+
+	int palette[4][3];
+	Unpack565(c0, palette[0]);
+	Unpack565(c1, palette[1]);
+	const bool fourColor = c0 > c1;
+	for (int c = 0; c < 3; c++)
+	{
+		palette[2][c] = fourColor ? (2 * palette[0][c] + palette[1][c]) / 3 : (palette[0][c] + palette[1][c]) / 2;
+		palette[3][c] = fourColor ? (palette[0][c] + 2 * palette[1][c]) / 3 : 0;
+	}
+
+	std::uint32_t indices = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		std::uint32_t best = 3;
+		if (!(transparent && block[i][3] < 128))
+		{
+			int bestDistance = INT_MAX;
+			for (std::uint32_t p = 0; p < (fourColor ? 4u : 3u); p++)
+			{
+				const int dr = block[i][0] - palette[p][0], dg = block[i][1] - palette[p][1], db = block[i][2] - palette[p][2];
+				if (const int distance = dr * dr + dg * dg + db * db; distance < bestDistance) { bestDistance = distance; best = p; }
+			}
+		}
+		indices |= best << (i * 2);
+	}
+
+	std::memcpy(out + 0, &c0, 2);
+	std::memcpy(out + 2, &c1, 2);
+	std::memcpy(out + 4, &indices, 4);
+}
+
+// BC3 alpha block: a0 = max > a1 = min, 8-value interpolated palette, 3-bit indices
+void EncodeAlphaBlock(const std::uint8_t block[16][4], std::uint8_t out[8])
+{
+	int lo = 255, hi = 0;
+	for (int i = 0; i < 16; i++) { lo = std::min(lo, int(block[i][3])); hi = std::max(hi, int(block[i][3])); }
+
+	out[0] = std::uint8_t(hi);
+	out[1] = std::uint8_t(lo);
+
+	int palette[8] = { hi, lo };
+	for (int p = 1; p < 7; p++) palette[p + 1] = ((7 - p) * hi + p * lo) / 7;
+
+	std::uint64_t indices = 0;
+	if (hi != lo)
+		for (int i = 0; i < 16; i++)
+		{
+			std::uint64_t best = 0;
+			int bestDistance = 256;
+			for (int p = 0; p < 8; p++)
+				if (const int distance = std::abs(block[i][3] - palette[p]); distance < bestDistance) { bestDistance = distance; best = std::uint64_t(p); }
+			indices |= best << (i * 3);
+		}
+
+	for (int b = 0; b < 6; b++) out[2 + b] = std::uint8_t(indices >> (b * 8));
+}
+
+std::vector<std::uint8_t> Encode(const Image &image, ctex::Format format)
+{
+	std::vector<std::uint8_t> out(ctex::GetLevelSize(format, image.width, image.height));
+	std::uint8_t *dst = out.data();
+
+	if (!ctex::IsCompressed(format))
+	{
+		for (std::uint32_t y = 0; y < image.height; y++)
+			for (std::uint32_t x = 0; x < image.width; x++)
+			{
+				const std::uint8_t *p = image.At(x, y);
+				if (format == ctex::Format::rgba8) { std::memcpy(dst, p, 4); dst += 4; continue; }
+
+				const std::uint16_t texel = format == ctex::Format::rgb565 ? Pack565(p[0], p[1], p[2]) : Pack4444(p[0], p[1], p[2], p[3]);
+				std::memcpy(dst, &texel, 2);
+				dst += 2;
+			}
+		return out;
+	}
+
+	for (std::uint32_t by = 0; by < image.height; by += 4)
+		for (std::uint32_t bx = 0; bx < image.width; bx += 4)
+		{
+			std::uint8_t block[16][4];
+			for (std::uint32_t i = 0; i < 16; i++)
+				std::memcpy(block[i], image.At(bx + i % 4, by + i / 4), 4);
+
+			if (format == ctex::Format::bc3)
+			{
+				EncodeAlphaBlock(block, dst);
+				EncodeColorBlock(block, false, dst + 8);
+				dst += 16;
+			}
+			else
+			{
+				EncodeColorBlock(block, true, dst);
+				dst += 8;
+			}
+		}
+	return out;
+}
+
+bool ParseFormat(const std::string &name, ctex::Format &format)
+{
+	static const std::pair<const char *, ctex::Format> formats[] = {
+		{ "rgba8", ctex::Format::rgba8 }, { "rgb565", ctex::Format::rgb565 }, { "rgba4", ctex::Format::rgba4 },
+		{ "bc1", ctex::Format::bc1 }, { "bc3", ctex::Format::bc3 },
+	};
+	for (const auto &[key, value] : formats)
+		if (name == key) { format = value; return true; }
+	return false;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 3)
+	{ std::cerr << "Usage: " << argv[0] << " <input> <output.ctex> [--format rgba8|rgb565|rgba4|bc1|bc3] [--no-mips]\n"; return EXIT_FAILURE; }
+
+	ctex::Format format = ctex::Format::rgba8;
+	bool mips = true;
+	for (int i = 3; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+		if (arg == "--no-mips") mips = false;
+		else if (arg == "--format" && i + 1 < argc && ParseFormat(argv[i + 1], format)) i++;
+		else { std::cerr << "Error: unknown argument: " << arg << std::endl; return EXIT_FAILURE; }
+	}
+
+	Image image;
+	{
+		stbi_set_flip_vertically_on_load(true); // OpenGL expects the first row to be the bottom one
+		int width, height, bpp;
+		stbi_uc *pixels = stbi_load(argv[1], &width, &height, &bpp, STBI_rgb_alpha);
+		if (!pixels)
+		{ std::cerr << "Error: fail to load image: " << argv[1] << ": " << stbi_failure_reason() << std::endl; return EXIT_FAILURE; }
+
+		image.width = std::uint32_t(width);
+		image.height = std::uint32_t(height);
+		image.rgba.assign(pixels, pixels + std::size_t(width) * height * 4);
+		stbi_image_free(pixels);
+	}
+
+	ctex::Header header{};
+	std::memcpy(header.magic, ctex::magic, sizeof(header.magic));
+	header.version = ctex::version;
+	header.format  = format;
+	header.width   = image.width;
+	header.height  = image.height;
+	header.flags   = ctex::flag_flipped;
+
+	std::vector<std::vector<std::uint8_t>> levels;
+	for (Image level = image;; level = Downsample(level))
+	{
+		levels.push_back(Encode(level, format));
+		if (!mips || (level.width == 1 && level.height == 1)) break;
+	}
+	header.levels = std::uint32_t(levels.size());
+
+	// lay out level data after the tables, each level aligned
+	auto align = [](std::uint64_t offset) { return (offset + ctex::alignment - 1) & ~std::uint64_t(ctex::alignment - 1); };
+	std::vector<ctex::Level> table(levels.size());
+	std::uint64_t offset = align(sizeof(ctex::Header) + sizeof(ctex::Level) * levels.size());
+	for (std::size_t i = 0; i < levels.size(); i++)
+	{
+		table[i].width  = std::max(image.width >> i, 1u);
+		table[i].height = std::max(image.height >> i, 1u);
+		table[i].offset = offset;
+		table[i].size   = levels[i].size();
+		offset = align(offset + levels[i].size());
+	}
+
+	std::ofstream file(argv[2], std::ios::binary | std::ios::trunc);
+	if (!file)
+	{ std::cerr << "Error: fail to open output path: " << argv[2] << std::endl; return EXIT_FAILURE; }
+
+	auto pad = [&file](std::uint64_t to) { const std::size_t n = std::size_t(to - std::uint64_t(file.tellp())); file.write(std::string(n, '\0').data(), std::streamsize(n)); };
+	file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char *>(table.data()), std::streamsize(sizeof(ctex::Level) * table.size()));
+	for (std::size_t i = 0; i < levels.size(); i++)
+	{
+		pad(table[i].offset);
+		file.write(reinterpret_cast<const char *>(levels[i].data()), std::streamsize(levels[i].size()));
+	}
+	pad(offset);
+
+	std::cout << "Info: " << argv[1] << " -> " << argv[2] << ": " << image.width << 'x' << image.height << ", " << levels.size() << " level(s), " << offset << " bytes\n";
+	return file ? EXIT_SUCCESS : EXIT_FAILURE;
+}